@@ -4,11 +4,23 @@
 #include "helper.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <concepts>
 #include <cstdint>
+#include <format>
+#include <generator>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <optional>
 #include <queue>
 #include <ranges>
+#include <span>
+#include <type_traits>
 #include <unordered_map>
+#include <variant>
+#include <vector>
 
 namespace AStar {
 template<typename Function, typename Position>
@@ -17,7 +29,7 @@ concept CostFunctionFor = requires(const Function& f, Position a, Position b) {
                           };
 
 template<typename ContainerType, typename Position>
-concept x = std::same_as<typename ContainerType::value_type, Position>;
+concept x = std::same_as<std::ranges::range_value_t<ContainerType>, Position>;
 
 template<typename Function, typename Position>
 concept NeighborFunctionFor = requires(const Function& f, Position a) {
@@ -41,128 +53,976 @@ struct Path {
 };
 
 template<Mode TheMode, typename Position>
-requires (TheMode == Mode::ReturnPath || TheMode == Mode::AllPaths)
+requires (TheMode == Mode::ReturnPath)
 struct Path<TheMode, Position> : std::vector<Position> {};
 
+/**
+ * @brief All shortest paths, as the graph of the predecessors on any of them.
+ *
+ * Node 0 is the end, the start is the only node without predecessors.
+ */
+template<typename Position>
+struct PredecessorDag {
+    std::vector<Position>                 Positions;
+    std::vector<std::vector<std::size_t>> Predecessors;
+
+    /**
+     * @brief Materializes the paths one at a time, each without the start and with the end, like Path.
+     */
+    std::generator<std::vector<Position>> paths(void) const {
+        struct Frame {
+            std::size_t Node;
+            std::size_t NextPredecessor;
+        };
+
+        if ( Positions.empty() ) {
+            //The end was not reached.
+            co_return;
+        } //if ( Positions.empty() )
+
+        std::vector<Frame>    stack{{0, 0}};
+        std::vector<Position> reversedPath;
+        if ( !Predecessors[0].empty() ) {
+            reversedPath.push_back(Positions[0]);
+        } //if ( !Predecessors[0].empty() )
+
+        while ( !stack.empty() ) {
+            auto&       frame        = stack.back();
+            const auto& predecessors = Predecessors[frame.Node];
+            if ( predecessors.empty() ) {
+                co_yield std::vector<Position>{reversedPath.rbegin(), reversedPath.rend()};
+                stack.pop_back();
+                continue;
+            } //if ( predecessors.empty() )
+
+            if ( frame.NextPredecessor == predecessors.size() ) {
+                reversedPath.pop_back();
+                stack.pop_back();
+                continue;
+            } //if ( frame.NextPredecessor == predecessors.size() )
+
+            const auto predecessor = predecessors[frame.NextPredecessor++];
+            if ( !Predecessors[predecessor].empty() ) {
+                reversedPath.push_back(Positions[predecessor]);
+            } //if ( !Predecessors[predecessor].empty() )
+            stack.push_back({predecessor, 0});
+        } //while ( !stack.empty() )
+    }
+};
+
 template<Mode TheMode, typename Position>
 struct AStarResult {
     std::vector<Path<TheMode, Position>> Paths;
     std::int64_t                         Cost;
 };
 
+template<typename Position>
+struct AStarResult<Mode::AllPaths, Position> {
+    PredecessorDag<Position> Paths;
+    std::int64_t             Cost;
+};
+
+/**
+ * @brief The result for start == end, a single empty path with the given cost.
+ */
+template<Mode TheMode, typename Position>
+AStarResult<TheMode, Position> trivialResult(const Position& end, std::int64_t cost) {
+    AStarResult<TheMode, Position> result{{}, cost};
+    if constexpr ( TheMode == Mode::AllPaths ) {
+        //A DAG with only the end, which is the start as well.
+        result.Paths.Positions.push_back(end);
+        result.Paths.Predecessors.emplace_back();
+    } //if constexpr ( TheMode == Mode::AllPaths )
+    else {
+        result.Paths.emplace_back();
+    } //else -> if constexpr ( TheMode == Mode::AllPaths )
+    return result;
+}
+
 template<typename Position>
 struct PairHash {
     static std::size_t operator()(const std::pair<Position, Position>& pair) noexcept {
-        constexpr bool isEnum = std::is_enum_v<Position>;
-        using Projection =
-            std::conditional_t<isEnum, decltype([](Position p) { return std::to_underlying(p); }), std::identity>;
-        using Hash = std::conditional_t<isEnum, std::hash<std::underlying_type_t<Position>>, std::hash<Position>>;
-        constexpr Hash       hash;
-        constexpr Projection projection;
-        return hash(projection(pair.first)) ^ hash(projection(pair.second));
+        constexpr auto hash = [](const Position& position) noexcept -> std::uint64_t {
+            if constexpr ( std::is_enum_v<Position> ) {
+                return std::hash<std::underlying_type_t<Position>>{}(std::to_underlying(position));
+            } //if constexpr ( std::is_enum_v<Position> )
+            else {
+                return std::hash<Position>{}(position);
+            } //else -> if constexpr ( std::is_enum_v<Position> )
+        };
+        return hashCombine(hash(pair.first), hash(pair.second));
     }
 };
 
-template<Mode TheMode, typename Position, CostFunctionFor<Position> CostFunction,
-         NeighborFunctionFor<Position> NeighborFunction, CostFunctionFor<Position> HeuristicFunction>
-AStarResult<TheMode, Position>
-findShortestPath(const Position& start, const Position& end, const CostFunction& costFunction,
-                 const NeighborFunction& neighborFunction, const HeuristicFunction& heuristicFunction) {
-    static std::unordered_map<std::pair<Position, Position>, AStarResult<TheMode, Position>, PairHash<Position>> cache;
+inline constexpr std::size_t NoNode = std::numeric_limits<std::size_t>::max();
 
-    if ( start == end ) {
-        return {{{}}, costFunction(end, end)};
-    } //if ( start == end )
+/**
+ * @brief Numbers the positions in the order they are reached, through a hash map.
+ */
+template<typename Position>
+class HashedStates {
+    public:
+    std::size_t capacity(void) const noexcept {
+        return 0;
+    }
 
-    if ( const auto iter = cache.find({start, end}); iter != cache.end() ) {
-        return iter->second;
-    } //if ( const auto iter = cache.find({start, end}); iter != cache.end() )
+    std::size_t nodeOf(const Position& position) {
+        return Index.insert({position, Index.size()}).first->second;
+    }
 
-    AStarResult<TheMode, Position> result;
-    result.Cost = -1;
+    std::size_t find(const Position& position) const noexcept {
+        const auto iter = Index.find(position);
+        return iter == Index.end() ? NoNode : iter->second;
+    }
+
+    private:
+    FlatHashMap<Position, std::size_t> Index;
+};
+
+/**
+ * @brief Positions with a caller supplied mapping onto [0, Count), e.g. the linear index of a grid coordinate.
+ *
+ * All per node data is allocated up front and addressed directly, no hashing involved.
+ */
+template<typename ToIndex>
+struct DenseStates {
+    std::size_t Count;
+    ToIndex     Index;
+
+    std::size_t capacity(void) const noexcept {
+        return Count;
+    }
+
+    template<typename Position>
+    std::size_t nodeOf(const Position& position) const noexcept {
+        return static_cast<std::size_t>(Index(position));
+    }
+
+    template<typename Position>
+    std::size_t find(const Position& position) const noexcept {
+        return nodeOf(position);
+    }
+};
+
+template<typename States, typename Position>
+concept StatesFor = requires(States& states, const Position& position) {
+                        { states.nodeOf(position) } -> std::same_as<std::size_t>;
+                        { std::as_const(states).find(position) } -> std::same_as<std::size_t>;
+                        { std::as_const(states).capacity() } -> std::same_as<std::size_t>;
+                    };
+
+/**
+ * @brief Every position reached by a search, once, with its best known cost and how it was reached.
+ *
+ * Paths are only reconstructed from the parent indices when asked for. In Mode::AllPaths a node keeps every
+ * predecessor with which it is reached at its best cost.
+ */
+template<Mode TheMode, typename Position, StatesFor<Position> States>
+class NodeArena {
+    public:
+    static constexpr std::int64_t Unreached = std::numeric_limits<std::int64_t>::max();
 
     struct Node {
-        Position                Pos;
-        Path<TheMode, Position> PathSoFar;
-        std::int64_t            Cost;
-        std::int64_t            Heuristic;
+        Position     Pos{};
+        std::int64_t Cost   = Unreached;
+        std::size_t  Parent = NoNode;
+        [[no_unique_address]] std::conditional_t<TheMode == Mode::AllPaths, std::vector<std::size_t>, std::monostate>
+            Predecessors;
+    };
+
+    explicit NodeArena(States states) : TheStates{std::move(states)}, Nodes(TheStates.capacity()) {
+        return;
+    }
+
+    const Node& operator[](std::size_t node) const noexcept {
+        return Nodes[node];
+    }
+
+    std::size_t size(void) const noexcept {
+        return Nodes.size();
+    }
+
+    /**
+     * @brief Records that position can be reached with cost through parent.
+     * @return The node of position, if it has to be (re)expanded, NoNode otherwise.
+     */
+    std::size_t relax(const Position& position, std::int64_t cost, std::size_t parent) {
+        const auto id = TheStates.nodeOf(position);
+        if ( id >= Nodes.size() ) {
+            Nodes.resize(id + 1);
+        } //if ( id >= Nodes.size() )
+
+        auto& node = Nodes[id];
+        if ( cost < node.Cost ) {
+            node.Pos    = position;
+            node.Cost   = cost;
+            node.Parent = parent;
+            if constexpr ( TheMode == Mode::AllPaths ) {
+                node.Predecessors.clear();
+                if ( parent != NoNode ) {
+                    node.Predecessors.push_back(parent);
+                } //if ( parent != NoNode )
+            } //if constexpr ( TheMode == Mode::AllPaths )
+            return id;
+        } //if ( cost < node.Cost )
+
+        if constexpr ( TheMode == Mode::AllPaths ) {
+            if ( cost == node.Cost && std::ranges::find(node.Predecessors, parent) == node.Predecessors.end() ) {
+                node.Predecessors.push_back(parent);
+            } //if ( cost == node.Cost && std::ranges::find(node.Predecessors, parent) == node.Predecessors.end() )
+        } //if constexpr ( TheMode == Mode::AllPaths )
+        return NoNode;
+    }
 
-        bool operator<(const Node& that) const noexcept {
-            return Heuristic > that.Heuristic;
+    /**
+     * @brief The node of position, NoNode if it was not reached.
+     */
+    std::size_t find(const Position& position) const noexcept {
+        const auto id = TheStates.find(position);
+        return id < Nodes.size() && Nodes[id].Cost != Unreached ? id : NoNode;
+    }
+
+    /**
+     * @brief The positions from the start (exclusive) to node (inclusive).
+     */
+    std::vector<Position> pathTo(std::size_t node) const {
+        std::vector<Position> ret;
+        for ( ; Nodes[node].Parent != NoNode; node = Nodes[node].Parent ) {
+            ret.push_back(Nodes[node].Pos);
+        } //for ( ; Nodes[node].Parent != NoNode; node = Nodes[node].Parent )
+        std::ranges::reverse(ret);
+        return ret;
+    }
+
+    /**
+     * @brief The positions from node (inclusive) back to the start (inclusive).
+     */
+    std::vector<Position> pathFrom(std::size_t node) const {
+        std::vector<Position> ret;
+        for ( ; node != NoNode; node = Nodes[node].Parent ) {
+            ret.push_back(Nodes[node].Pos);
+        } //for ( ; node != NoNode; node = Nodes[node].Parent )
+        return ret;
+    }
+
+    /**
+     * @brief Extracts the nodes on any shortest path to node.
+     */
+    PredecessorDag<Position> dagTo(std::size_t node) const
+        requires (TheMode == Mode::AllPaths)
+    {
+        PredecessorDag<Position> ret;
+        std::vector<std::size_t> dagIds(Nodes.size(), NoNode);
+        std::vector<std::size_t> toVisit{node};
+        dagIds[node] = 0;
+        ret.Positions.push_back(Nodes[node].Pos);
+        ret.Predecessors.emplace_back();
+
+        while ( !toVisit.empty() ) {
+            const auto current = toVisit.back();
+            toVisit.pop_back();
+            for ( const auto predecessor : Nodes[current].Predecessors ) {
+                if ( dagIds[predecessor] == NoNode ) {
+                    dagIds[predecessor] = ret.Positions.size();
+                    ret.Positions.push_back(Nodes[predecessor].Pos);
+                    ret.Predecessors.emplace_back();
+                    toVisit.push_back(predecessor);
+                } //if ( dagIds[predecessor] == NoNode )
+                ret.Predecessors[dagIds[current]].push_back(dagIds[predecessor]);
+            } //for ( const auto predecessor : Nodes[current].Predecessors )
+        } //while ( !toVisit.empty() )
+        return ret;
+    }
+
+    private:
+    States            TheStates;
+    std::vector<Node> Nodes;
+};
+
+struct QueueEntry {
+    std::int64_t Key;
+    std::int64_t Cost;
+    std::size_t  Node;
+
+    /**
+     * @brief Orders by key, ties are broken towards the higher cost, which usually is closer to the end.
+     */
+    bool before(const QueueEntry& that) const noexcept {
+        return Key < that.Key || (Key == that.Key && Cost > that.Cost);
+    }
+};
+
+/**
+ * @brief The open set as std::priority_queue, improved nodes are pushed again and outdated entries skipped on pop.
+ */
+class LazyHeap {
+    public:
+    std::size_t size(void) const noexcept {
+        return Heap.size();
+    }
+
+    /**
+     * @brief Queues node with key and its cost, if it is not already queued with a key at most as large.
+     */
+    void push(std::size_t node, std::int64_t key, std::int64_t cost) {
+        if ( node >= BestKeys.size() ) {
+            BestKeys.resize(node + 1, std::numeric_limits<std::int64_t>::max());
+        } //if ( node >= BestKeys.size() )
+
+        if ( key < BestKeys[node] ) {
+            BestKeys[node] = key;
+            Heap.push({key, cost, node});
+        } //if ( key < BestKeys[node] )
+        return;
+    }
+
+    std::optional<QueueEntry> pop(void) {
+        while ( !Heap.empty() ) {
+            const auto entry = Heap.top();
+            Heap.pop();
+            if ( entry.Key == BestKeys[entry.Node] ) {
+                BestKeys[entry.Node] = std::numeric_limits<std::int64_t>::max();
+                return entry;
+            } //if ( entry.Key == BestKeys[entry.Node] )
+            ++StalePops;
+        } //while ( !Heap.empty() )
+        return std::nullopt;
+    }
+
+    /**
+     * @brief How many outdated entries pop() skipped.
+     */
+    std::size_t stalePops(void) const noexcept {
+        return StalePops;
+    }
+
+    private:
+    struct Greater {
+        static bool operator()(const QueueEntry& lhs, const QueueEntry& rhs) noexcept {
+            return rhs.before(lhs);
         }
     };
 
-    auto buildHeuristic = [end, &heuristicFunction](const Position& pos) noexcept {
-        return heuristicFunction(pos, end);
-    };
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, Greater> Heap;
+    std::vector<std::int64_t>                                         BestKeys;
+    std::size_t                                                       StalePops = 0;
+};
 
-    std::priority_queue<Node>                  queue;
-    std::unordered_map<Position, std::int64_t> visited;
+/**
+ * @brief The open set as indexed d-ary min heap, every node is queued at most once and its key decreased in place.
+ */
+template<std::size_t Arity = 4>
+class IndexedHeap {
+    static_assert(Arity >= 2);
 
-    queue.emplace(start, Path<TheMode, Position>{}, 0, buildHeuristic(start));
+    public:
+    std::size_t size(void) const noexcept {
+        return Heap.size();
+    }
+
+    /**
+     * @brief Queues node with key and its cost, or decreases its key, if it is already queued with a larger one.
+     */
+    void push(std::size_t node, std::int64_t key, std::int64_t cost) {
+        if ( node >= Slots.size() ) {
+            Slots.resize(node + 1, NotQueued);
+        } //if ( node >= Slots.size() )
 
-    while ( !queue.empty() ) {
-        Node current = queue.top();
-        queue.pop();
+        auto slot = Slots[node];
+        if ( slot == NotQueued ) {
+            slot = Heap.size();
+            Heap.push_back({key, cost, node});
+        } //if ( slot == NotQueued )
+        else if ( key < Heap[slot].Key ) {
+            Heap[slot] = {key, cost, node};
+        } //else if ( key < Heap[slot].Key )
+        else {
+            return;
+        } //else -> else if ( key < Heap[slot].Key )
+        siftUp(slot);
+        return;
+    }
 
-        if ( current.Pos == end ) {
-            if ( result.Cost == -1 ) {
-                throwIfInvalid(result.Paths.empty());
-                result.Cost = current.Cost;
-            } //if ( result.Cost == -1 )
-            else if ( current.Cost > result.Cost ) {
-                cache.emplace(std::pair{start, end}, result);
-                return result;
-            } //else if ( current.Cost > result.Cost )
+    std::optional<QueueEntry> pop(void) {
+        if ( Heap.empty() ) {
+            return std::nullopt;
+        } //if ( Heap.empty() )
 
-            throwIfInvalid(current.PathSoFar.back() == end);
-            result.Paths.emplace_back(std::move(current.PathSoFar));
+        const auto ret  = Heap.front();
+        Slots[ret.Node] = NotQueued;
+        const auto last = Heap.back();
+        Heap.pop_back();
+        if ( !Heap.empty() ) {
+            Heap.front() = last;
+            siftDown(0);
+        } //if ( !Heap.empty() )
+        return ret;
+    }
+
+    /**
+     * @brief Always 0, there are no outdated entries.
+     */
+    std::size_t stalePops(void) const noexcept {
+        return 0;
+    }
+
+    private:
+    static constexpr std::size_t NotQueued = std::numeric_limits<std::size_t>::max();
+
+    std::vector<QueueEntry>  Heap;
+    std::vector<std::size_t> Slots;
+
+    void place(std::size_t slot, const QueueEntry& entry) noexcept {
+        Heap[slot]        = entry;
+        Slots[entry.Node] = slot;
+        return;
+    }
+
+    void siftUp(std::size_t slot) noexcept {
+        const auto entry = Heap[slot];
+        while ( slot > 0 ) {
+            const auto parent = (slot - 1) / Arity;
+            if ( !entry.before(Heap[parent]) ) {
+                break;
+            } //if ( !entry.before(Heap[parent]) )
+            place(slot, Heap[parent]);
+            slot = parent;
+        } //while ( slot > 0 )
+        place(slot, entry);
+        return;
+    }
+
+    void siftDown(std::size_t slot) noexcept {
+        const auto entry = Heap[slot];
+        while ( true ) {
+            const auto firstChild = slot * Arity + 1;
+            if ( firstChild >= Heap.size() ) {
+                break;
+            } //if ( firstChild >= Heap.size() )
+
+            auto       smallest  = firstChild;
+            const auto lastChild = std::min(firstChild + Arity, Heap.size());
+            for ( auto child = firstChild + 1; child < lastChild; ++child ) {
+                if ( Heap[child].before(Heap[smallest]) ) {
+                    smallest = child;
+                } //if ( Heap[child].before(Heap[smallest]) )
+            } //for ( auto child = firstChild + 1; child < lastChild; ++child )
+
+            if ( !Heap[smallest].before(entry) ) {
+                break;
+            } //if ( !Heap[smallest].before(entry) )
+            place(slot, Heap[smallest]);
+            slot = smallest;
+        } //while ( true )
+        place(slot, entry);
+        return;
+    }
+};
+
+template<typename Queue>
+concept OpenSet = requires(Queue& queue, std::size_t node, std::int64_t key, std::int64_t cost) {
+                      queue.push(node, key, cost);
+                      { queue.pop() } -> std::same_as<std::optional<QueueEntry>>;
+                      { std::as_const(queue).size() } -> std::same_as<std::size_t>;
+                      { std::as_const(queue).stalePops() } -> std::same_as<std::size_t>;
+                  };
+
+/**
+ * @brief The default statistics policy, all hooks are empty and compiled out.
+ */
+struct NoStatistics {
+    void searchStarted(void) noexcept {
+        return;
+    }
+
+    void expanded(void) noexcept {
+        return;
+    }
+
+    void queued(std::size_t /*openSetSize*/) noexcept {
+        return;
+    }
 
+    void searchFinished(std::size_t /*stalePops*/) noexcept {
+        return;
+    }
+
+    void cacheLookedUp(bool /*hit*/) noexcept {
+        return;
+    }
+};
+
+inline NoStatistics noStatistics;
+
+/**
+ * @brief Sums up the work of all searches it is passed to, to tune heuristics and open sets.
+ */
+class SearchStatistics {
+    public:
+    std::size_t              Searches    = 0;
+    std::size_t              Expansions  = 0;
+    std::size_t              Pushes      = 0;
+    std::size_t              StalePops   = 0;
+    std::size_t              PeakOpenSet = 0;
+    std::size_t              CacheHits   = 0;
+    std::size_t              CacheMisses = 0;
+    std::chrono::nanoseconds Duration{};
+
+    void searchStarted(void) noexcept {
+        ++Searches;
+        Start = std::chrono::steady_clock::now();
+        return;
+    }
+
+    void expanded(void) noexcept {
+        ++Expansions;
+        return;
+    }
+
+    void queued(std::size_t openSetSize) noexcept {
+        ++Pushes;
+        PeakOpenSet = std::max(PeakOpenSet, openSetSize);
+        return;
+    }
+
+    void searchFinished(std::size_t stalePops) noexcept {
+        StalePops += stalePops;
+        Duration  += std::chrono::steady_clock::now() - Start;
+        return;
+    }
+
+    void cacheLookedUp(bool hit) noexcept {
+        ++(hit ? CacheHits : CacheMisses);
+        return;
+    }
+
+    private:
+    std::chrono::steady_clock::time_point Start;
+};
+
+template<typename Statistics>
+concept StatisticsPolicy = requires(Statistics& statistics, std::size_t count, bool hit) {
+                               statistics.searchStarted();
+                               statistics.expanded();
+                               statistics.queued(count);
+                               statistics.searchFinished(count);
+                               statistics.cacheLookedUp(hit);
+                           };
+
+/**
+ * @brief The search itself, without any caching.
+ *
+ * For start == end no search is done, the result is a single empty path with the cost costFunction(end, end).
+ * @param states Defines how positions are mapped onto nodes, HashedStates or DenseStates.
+ * @param statistics Records the work done, e.g. a SearchStatistics.
+ */
+template<Mode TheMode, OpenSet Queue = IndexedHeap<>, typename Position, CostFunctionFor<Position> CostFunction,
+         NeighborFunctionFor<Position> NeighborFunction, CostFunctionFor<Position> HeuristicFunction,
+         StatesFor<Position> States = HashedStates<Position>, StatisticsPolicy Statistics = NoStatistics>
+AStarResult<TheMode, Position> search(const Position& start, const Position& end, const CostFunction& costFunction,
+                                      const NeighborFunction& neighborFunction,
+                                      const HeuristicFunction& heuristicFunction, States states = {},
+                                      Statistics& statistics = noStatistics) {
+    statistics.searchStarted();
+    if ( start == end ) {
+        statistics.searchFinished(0);
+        return trivialResult<TheMode>(end, costFunction(end, end));
+    } //if ( start == end )
+
+    NodeArena<TheMode, Position, States> nodes{std::move(states)};
+    Queue                                queue;
+    std::size_t                          endNode = NoNode;
+    std::int64_t                         endCost = -1;
+
+    queue.push(nodes.relax(start, 0, NoNode), heuristicFunction(start, end), 0);
+    statistics.queued(queue.size());
+
+    while ( const auto current = queue.pop() ) {
+        if ( endNode != NoNode && current->Key > endCost ) {
+            //Only reachable in Mode::AllPaths, no further path can be as short.
+            break;
+        } //if ( endNode != NoNode && current->Key > endCost )
+
+        const Position     position = nodes[current->Node].Pos;
+        const std::int64_t cost     = nodes[current->Node].Cost;
+        if ( position == end ) {
+            endNode = current->Node;
+            endCost = cost;
             if constexpr ( TheMode != Mode::AllPaths ) {
-                cache.emplace(std::pair{start, end}, result);
-                return result;
-            } //if constexpr ( Mode != Mode::AllPaths )
+                break;
+            } //if constexpr ( TheMode != Mode::AllPaths )
             continue;
-        } //if ( current.Pos == end )
+        } //if ( position == end )
+
+        statistics.expanded();
+        for ( const Position& next : neighborFunction(position) ) {
+            const auto nextCost = cost + costFunction(position, next);
+            if ( const auto node = nodes.relax(next, nextCost, current->Node); node != NoNode ) {
+                queue.push(node, nextCost + heuristicFunction(next, end), nextCost);
+                statistics.queued(queue.size());
+            } //if ( const auto node = nodes.relax(next, nextCost, current->Node); node != NoNode )
+        } //for ( const Position& next : neighborFunction(position) )
+    } //while ( const auto current = queue.pop() )
+    statistics.searchFinished(queue.stalePops());
 
+    AStarResult<TheMode, Position> result{{}, endCost};
+    if ( endNode != NoNode ) {
         if constexpr ( TheMode == Mode::AllPaths ) {
-            if ( result.Cost != -1 && current.Cost >= result.Cost ) {
-                cache.emplace(std::pair{start, end}, result);
-                return result;
-            } //if ( result.Cost != -1 && current.Cost >= result.Cost )
+            result.Paths = nodes.dagTo(endNode);
         } //if constexpr ( TheMode == Mode::AllPaths )
+        else if constexpr ( TheMode == Mode::ReturnPath ) {
+            result.Paths.emplace_back(nodes.pathTo(endNode));
+        } //else if constexpr ( TheMode == Mode::ReturnPath )
+        else {
+            result.Paths.emplace_back();
+        } //else -> if constexpr ( TheMode == Mode::ReturnPath )
+    } //if ( endNode != NoNode )
+    return result;
+}
 
-        if ( const auto iter = visited.find(current.Pos); iter != visited.end() ) {
-            if ( iter->second < current.Cost ) {
-                continue;
-            } //if ( iter->second < current.Cost )
+/**
+ * @brief Searches from both ends at once, expanding the side with the smaller open set.
+ *
+ * The backward search walks the edges in reverse through predecessorFunction, for undirected graphs that is the
+ * neighborFunction again. It stops as soon as one side can no longer improve on the best meeting found, which is
+ * exact for consistent heuristics. Mode::AllPaths is not supported, start == end is handled like in search.
+ */
+template<Mode TheMode, OpenSet Queue = IndexedHeap<>, typename Position, CostFunctionFor<Position> CostFunction,
+         NeighborFunctionFor<Position> NeighborFunction, NeighborFunctionFor<Position> PredecessorFunction,
+         CostFunctionFor<Position> HeuristicFunction, StatesFor<Position> States = HashedStates<Position>,
+         StatisticsPolicy Statistics = NoStatistics>
+requires (TheMode != Mode::AllPaths)
+AStarResult<TheMode, Position>
+searchBidirectional(const Position& start, const Position& end, const CostFunction& costFunction,
+                    const NeighborFunction& neighborFunction, const PredecessorFunction& predecessorFunction,
+                    const HeuristicFunction& heuristicFunction, States states = {},
+                    Statistics& statistics = noStatistics) {
+    using Arena = NodeArena<TheMode, Position, States>;
 
-            if constexpr ( TheMode != Mode::AllPaths ) {
-                if ( iter->second <= current.Cost ) {
-                    continue;
-                } //if ( iter->second <= current.Cost )
-            } //if constexpr ( TheMode != Mode::AllPaths )
+    statistics.searchStarted();
+    if ( start == end ) {
+        statistics.searchFinished(0);
+        return trivialResult<TheMode>(end, costFunction(end, end));
+    } //if ( start == end )
+
+    Arena        forward{states};
+    Arena        backward{std::move(states)};
+    Queue        forwardQueue;
+    Queue        backwardQueue;
+    std::int64_t best         = Arena::Unreached;
+    std::size_t  meetForward  = NoNode;
+    std::size_t  meetBackward = NoNode;
+
+    const auto startEstimate  = heuristicFunction(start, end);
+    forwardQueue.push(forward.relax(start, 0, NoNode), startEstimate, 0);
+    backwardQueue.push(backward.relax(end, 0, NoNode), startEstimate, 0);
+    statistics.queued(forwardQueue.size() + backwardQueue.size());
 
-            iter->second = current.Cost;
-        } //if ( const auto iter = visited.find(current.Pos); iter != visited.end() )
+    //Expands the cheapest node of one side, returns false when that side can not lead to a better path.
+    auto step = [&](Arena& nodes, Queue& queue, const Arena& other, const auto& nextFunction, bool isForward) {
+        const auto current = queue.pop();
+        if ( !current || current->Key >= best ) {
+            return false;
+        } //if ( !current || current->Key >= best )
+
+        statistics.expanded();
+        const Position     position = nodes[current->Node].Pos;
+        const std::int64_t cost     = nodes[current->Node].Cost;
+        for ( const Position& next : nextFunction(position) ) {
+            const auto nextCost = cost + (isForward ? costFunction(position, next) : costFunction(next, position));
+            if ( const auto otherNode = other.find(next); otherNode != NoNode ) {
+                if ( const auto total = nextCost + other[otherNode].Cost; total < best ) {
+                    best         = total;
+                    meetForward  = isForward ? current->Node : otherNode;
+                    meetBackward = isForward ? otherNode : current->Node;
+                } //if ( const auto total = nextCost + other[otherNode].Cost; total < best )
+            } //if ( const auto otherNode = other.find(next); otherNode != NoNode )
+
+            if ( const auto node = nodes.relax(next, nextCost, current->Node); node != NoNode ) {
+                const auto estimate = isForward ? heuristicFunction(next, end) : heuristicFunction(start, next);
+                queue.push(node, nextCost + estimate, nextCost);
+                statistics.queued(forwardQueue.size() + backwardQueue.size());
+            } //if ( const auto node = nodes.relax(next, nextCost, current->Node); node != NoNode )
+        } //for ( const Position& next : nextFunction(position) )
+        return true;
+    };
+
+    for ( bool searching = true; searching; ) {
+        if ( forwardQueue.size() <= backwardQueue.size() ) {
+            searching = step(forward, forwardQueue, backward, neighborFunction, true);
+        } //if ( forwardQueue.size() <= backwardQueue.size() )
         else {
-            visited.emplace(current.Pos, current.Cost);
-        } //else -> if ( const auto iter = visited.find(current.Pos); iter != visited.end() )
-
-        std::ranges::for_each(
-            neighborFunction(current.Pos) |
-                std::views::transform([&current, &costFunction, &buildHeuristic](const Position& pos) noexcept {
-                    const auto cost = current.Cost + costFunction(current.Pos, pos);
-                    return Node{pos,
-                                std::views::concat(current.PathSoFar, std::views::single(pos)) |
-                                    std::ranges::to<std::vector>(),
-                                cost, cost + buildHeuristic(pos)};
-                }),
-            [&queue](Node node) noexcept { queue.push(std::move(node)); });
-    } //while ( !queue.empty() )
+            searching = step(backward, backwardQueue, forward, predecessorFunction, false);
+        } //else -> if ( forwardQueue.size() <= backwardQueue.size() )
+    } //for ( bool searching = true; searching; )
+    statistics.searchFinished(forwardQueue.stalePops() + backwardQueue.stalePops());
+
+    AStarResult<TheMode, Position> result{{}, -1};
+    if ( meetForward == NoNode ) {
+        return result;
+    } //if ( meetForward == NoNode )
 
+    result.Cost = best;
+    if constexpr ( TheMode == Mode::ReturnPath ) {
+        auto path = forward.pathTo(meetForward);
+        std::ranges::copy(backward.pathFrom(meetBackward), std::back_inserter(path));
+        result.Paths.emplace_back(std::move(path));
+    } //if constexpr ( TheMode == Mode::ReturnPath )
+    else {
+        result.Paths.emplace_back();
+    } //else -> if constexpr ( TheMode == Mode::ReturnPath )
+    return result;
+}
+
+/**
+ * @brief Runs Dijkstra from start and calls visitor(position, cost) for every position in the order it is settled.
+ *
+ * The expansion stops early when the visitor returns false.
+ */
+template<OpenSet Queue = IndexedHeap<>, typename Position, CostFunctionFor<Position> CostFunction,
+         NeighborFunctionFor<Position> NeighborFunction, typename Visitor,
+         StatesFor<Position> States = HashedStates<Position>>
+requires std::is_invocable_r_v<bool, Visitor&, const Position&, std::int64_t>
+void explore(const Position& start, const CostFunction& costFunction, const NeighborFunction& neighborFunction,
+             Visitor&& visitor, States states = {}) {
+    NodeArena<Mode::Default, Position, States> nodes{std::move(states)};
+    Queue                                      queue;
+    queue.push(nodes.relax(start, 0, NoNode), 0, 0);
+
+    while ( const auto current = queue.pop() ) {
+        const Position     position = nodes[current->Node].Pos;
+        const std::int64_t cost     = nodes[current->Node].Cost;
+        if ( !visitor(position, cost) ) {
+            return;
+        } //if ( !visitor(position, cost) )
+
+        for ( const Position& next : neighborFunction(position) ) {
+            const auto nextCost = cost + costFunction(position, next);
+            if ( const auto node = nodes.relax(next, nextCost, current->Node); node != NoNode ) {
+                queue.push(node, nextCost, nextCost);
+            } //if ( const auto node = nodes.relax(next, nextCost, current->Node); node != NoNode )
+        } //for ( const Position& next : neighborFunction(position) )
+    } //while ( const auto current = queue.pop() )
+    return;
+}
+
+template<typename Position>
+struct Distance {
+    Position     Pos;
+    std::int64_t Cost;
+};
+
+/**
+ * @brief The cost from start to every reachable position, in increasing order.
+ */
+template<OpenSet Queue = IndexedHeap<>, typename Position, CostFunctionFor<Position> CostFunction,
+         NeighborFunctionFor<Position> NeighborFunction, StatesFor<Position> States = HashedStates<Position>>
+std::vector<Distance<Position>> distanceField(const Position& start, const CostFunction& costFunction,
+                                              const NeighborFunction& neighborFunction, States states = {}) {
+    std::vector<Distance<Position>> ret;
+    explore<Queue>(
+        start, costFunction, neighborFunction,
+        [&ret](const Position& position, std::int64_t cost) {
+            ret.push_back({position, cost});
+            return true;
+        },
+        std::move(states));
+    return ret;
+}
+
+/**
+ * @brief The costs from start to each of the targets with a single expansion, -1 for unreachable targets.
+ */
+template<OpenSet Queue = IndexedHeap<>, typename Position, CostFunctionFor<Position> CostFunction,
+         NeighborFunctionFor<Position> NeighborFunction, StatesFor<Position> States = HashedStates<Position>>
+std::vector<std::int64_t> distancesTo(const Position& start, std::span<const Position> targets,
+                                      const CostFunction& costFunction, const NeighborFunction& neighborFunction,
+                                      States states = {}) {
+    FlatHashMap<Position, std::int64_t> costs;
+    for ( const auto& target : targets ) {
+        costs[target] = -1;
+    } //for ( const auto& target : targets )
+
+    auto remaining = costs.size();
+    explore<Queue>(
+        start, costFunction, neighborFunction,
+        [&costs, &remaining](const Position& position, std::int64_t cost) {
+            if ( const auto iter = costs.find(position); iter != costs.end() ) {
+                iter->second = cost;
+                --remaining;
+            } //if ( const auto iter = costs.find(position); iter != costs.end() )
+            return remaining != 0;
+        },
+        std::move(states));
+    return targets | std::views::transform([&costs](const Position& target) { return costs.find(target)->second; }) |
+           std::ranges::to<std::vector>();
+}
+
+/**
+ * @brief A mutex which does nothing, for caches used by one thread only.
+ */
+struct NoMutex {
+    void lock(void) noexcept {
+        return;
+    }
+
+    void unlock(void) noexcept {
+        return;
+    }
+};
+
+/**
+ * @brief Caches search results by start and end, evicting the least recently used ones above the capacity.
+ *
+ * With Mutex = std::mutex the cache can be shared between threads, the entries are then distributed over shards with
+ * their own lock and LRU list, each holding an equal part of the capacity.
+ */
+template<Mode TheMode, typename Position, typename Mutex = NoMutex>
+class ResultCache {
+    public:
+    using Key    = std::pair<Position, Position>;
+    using Result = AStarResult<TheMode, Position>;
+
+    explicit ResultCache(std::size_t capacity, std::size_t shards = 1) :
+            ShardCapacity{std::max<std::size_t>(1, (capacity + shards - 1) / std::max<std::size_t>(1, shards))},
+            Shards(std::max<std::size_t>(1, shards)) {
+        return;
+    }
+
+    std::optional<Result> find(const Key& key) {
+        auto&           shard = shardOf(key);
+        std::lock_guard lock{shard.Lock};
+        const auto      iter = shard.Index.find(key);
+        if ( iter == shard.Index.end() ) {
+            Misses.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        } //if ( iter == shard.Index.end() )
+
+        Hits.fetch_add(1, std::memory_order_relaxed);
+        shard.Entries.splice(shard.Entries.begin(), shard.Entries, iter->second);
+        return iter->second->second;
+    }
+
+    void insert(const Key& key, Result result) {
+        auto&           shard = shardOf(key);
+        std::lock_guard lock{shard.Lock};
+        if ( const auto iter = shard.Index.find(key); iter != shard.Index.end() ) {
+            //Another thread was faster.
+            shard.Entries.splice(shard.Entries.begin(), shard.Entries, iter->second);
+            return;
+        } //if ( const auto iter = shard.Index.find(key); iter != shard.Index.end() )
+
+        if ( shard.Entries.size() == ShardCapacity ) {
+            shard.Index.erase(shard.Entries.back().first);
+            shard.Entries.pop_back();
+            Evictions.fetch_add(1, std::memory_order_relaxed);
+        } //if ( shard.Entries.size() == ShardCapacity )
+        shard.Entries.emplace_front(key, std::move(result));
+        shard.Index.emplace(key, shard.Entries.begin());
+        return;
+    }
+
+    void clear(void) {
+        for ( auto& shard : Shards ) {
+            std::lock_guard lock{shard.Lock};
+            shard.Index.clear();
+            shard.Entries.clear();
+        } //for ( auto& shard : Shards )
+        return;
+    }
+
+    std::size_t size(void) {
+        std::size_t ret = 0;
+        for ( auto& shard : Shards ) {
+            std::lock_guard lock{shard.Lock};
+            ret += shard.Entries.size();
+        } //for ( auto& shard : Shards )
+        return ret;
+    }
+
+    std::size_t hits(void) const noexcept {
+        return Hits.load(std::memory_order_relaxed);
+    }
+
+    std::size_t misses(void) const noexcept {
+        return Misses.load(std::memory_order_relaxed);
+    }
+
+    std::size_t evictions(void) const noexcept {
+        return Evictions.load(std::memory_order_relaxed);
+    }
+
+    private:
+    using EntryList = std::list<std::pair<Key, Result>>;
+
+    struct Shard {
+        [[no_unique_address]] Mutex                                                Lock;
+        EntryList                                                                  Entries;
+        std::unordered_map<Key, typename EntryList::iterator, PairHash<Position>> Index;
+    };
+
+    std::size_t              ShardCapacity;
+    std::vector<Shard>       Shards;
+    std::atomic<std::size_t> Hits      = 0;
+    std::atomic<std::size_t> Misses    = 0;
+    std::atomic<std::size_t> Evictions = 0;
+
+    Shard& shardOf(const Key& key) noexcept {
+        return Shards[PairHash<Position>{}(key) % Shards.size()];
+    }
+};
+
+/**
+ * @brief Looks the path up in the cache, searches and stores it on a miss.
+ */
+template<Mode TheMode, OpenSet Queue = IndexedHeap<>, typename Position, typename Mutex,
+         CostFunctionFor<Position> CostFunction, NeighborFunctionFor<Position> NeighborFunction,
+         CostFunctionFor<Position> HeuristicFunction, StatesFor<Position> States = HashedStates<Position>,
+         StatisticsPolicy Statistics = NoStatistics>
+AStarResult<TheMode, Position>
+findShortestPath(ResultCache<TheMode, Position, Mutex>& cache, const Position& start, const Position& end,
+                 const CostFunction& costFunction, const NeighborFunction& neighborFunction,
+                 const HeuristicFunction& heuristicFunction, States states = {},
+                 Statistics& statistics = noStatistics) {
+    if ( start == end ) {
+        return trivialResult<TheMode>(end, costFunction(end, end));
+    } //if ( start == end )
+
+    auto cached = cache.find({start, end});
+    statistics.cacheLookedUp(cached.has_value());
+    if ( cached ) {
+        return std::move(*cached);
+    } //if ( cached )
+
+    auto result = search<TheMode, Queue>(start, end, costFunction, neighborFunction, heuristicFunction,
+                                         std::move(states), statistics);
+    cache.insert({start, end}, result);
     return result;
 }
 } //namespace AStar
 
+namespace std {
+template<>
+struct formatter<AStar::SearchStatistics, char> {
+    template<typename Context>
+    constexpr auto parse(Context& ctx) {
+        auto iter = ctx.begin();
+        if ( iter != ctx.end() && *iter != '}' ) {
+            throw std::format_error{"We don't parse!"};
+        } //if ( iter != ctx.end() && *iter != '}' )
+        return iter;
+    }
+
+    template<typename Context>
+    auto format(const AStar::SearchStatistics& s, Context& ctx) const {
+        return std::format_to(ctx.out(),
+                              "{:d} searches, {:d} expansions, {:d} pushes, {:d} stale pops, peak open set {:d}, "
+                              "cache {:d}/{:d} hits, {:.3f}ms",
+                              s.Searches, s.Expansions, s.Pushes, s.StalePops, s.PeakOpenSet, s.CacheHits,
+                              s.CacheHits + s.CacheMisses,
+                              std::chrono::duration<double, std::milli>{s.Duration}.count());
+    }
+};
+} //namespace std
+
 #endif //ASTAR_HPP
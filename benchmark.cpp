@@ -0,0 +1,74 @@
+#include "benchmark.hpp"
+
+#include "helper.hpp"
+#include "print.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+std::vector<std::pair<std::string_view, MicroBenchmark>>& microBenchmarks(void) noexcept {
+    static std::vector<std::pair<std::string_view, MicroBenchmark>> benchmarks;
+    return benchmarks;
+}
+} //namespace
+
+Statistics calculateStatistics(std::vector<std::chrono::nanoseconds> samples) {
+    throwIfInvalid(!samples.empty(), "No samples");
+    std::ranges::sort(samples);
+
+    const auto size     = samples.size();
+    const auto middle   = size / 2;
+    const auto median   = size % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+    //Nearest rank.
+    const auto p95Index = (size * 95 + 99) / 100 - 1;
+
+    double sum          = 0.;
+    for ( const auto sample : samples ) {
+        sum += static_cast<double>(sample.count());
+    } //for ( const auto sample : samples )
+    const auto mean = sum / static_cast<double>(size);
+
+    double squaredDiff = 0.;
+    for ( const auto sample : samples ) {
+        const auto diff  = static_cast<double>(sample.count()) - mean;
+        squaredDiff     += diff * diff;
+    } //for ( const auto sample : samples )
+    const auto variance = size > 1 ? squaredDiff / static_cast<double>(size - 1) : 0.;
+
+    return {.Runs     = size,
+            .Min      = samples.front(),
+            .Median   = median,
+            .P95      = samples[p95Index],
+            .Max      = samples.back(),
+            .MeanNs   = mean,
+            .StdDevNs = std::sqrt(variance)};
+}
+
+void MicroBenchmarkContext::report(std::string_view label, const Statistics& statistics) const {
+    myPrint("   {:s}: {}\n", label, statistics);
+    return;
+}
+
+bool registerMicroBenchmark(std::string_view name, MicroBenchmark benchmark) {
+    microBenchmarks().emplace_back(name, benchmark);
+    return true;
+}
+
+std::size_t runMicroBenchmarks(std::string_view filter, const MicroBenchmarkContext& context) {
+    auto benchmarks = microBenchmarks();
+    std::ranges::sort(benchmarks, {}, [](const auto& entry) noexcept { return entry.first; });
+
+    std::size_t ret = 0;
+    for ( const auto& [name, benchmark] : benchmarks ) {
+        if ( !name.contains(filter) ) {
+            continue;
+        } //if ( !name.contains(filter) )
+
+        myPrint(" == Micro Benchmark {:s} ==\n", name);
+        benchmark(context);
+        ++ret;
+    } //for ( const auto& [name, benchmark] : benchmarks )
+    return ret;
+}
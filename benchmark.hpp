@@ -0,0 +1,105 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <string_view>
+#include <vector>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+struct Statistics {
+    std::size_t              Runs;
+    std::chrono::nanoseconds Min;
+    std::chrono::nanoseconds Median;
+    std::chrono::nanoseconds P95;
+    std::chrono::nanoseconds Max;
+    double                   MeanNs;
+    double                   StdDevNs;
+};
+
+Statistics calculateStatistics(std::vector<std::chrono::nanoseconds> samples);
+
+/**
+ * @brief Calls function warmUpRuns times without measuring, then runs times and returns the duration of every run.
+ */
+template<typename Function>
+std::vector<std::chrono::nanoseconds> sampleRuns(std::size_t warmUpRuns, std::size_t runs, Function&& function) {
+    for ( ; warmUpRuns > 0; --warmUpRuns ) {
+        function();
+    } //for ( ; warmUpRuns > 0; --warmUpRuns )
+
+    std::vector<std::chrono::nanoseconds> ret;
+    ret.reserve(runs);
+    for ( ; runs > 0; --runs ) {
+        const auto start = BenchmarkClock::now();
+        function();
+        const auto end = BenchmarkClock::now();
+        ret.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start));
+    } //for ( ; runs > 0; --runs )
+    return ret;
+}
+
+/**
+ * @brief Keeps the compiler from optimizing value (and its computation) away.
+ */
+template<typename T>
+void doNotOptimize(const T& value) noexcept {
+    asm volatile("" : : "g"(&value) : "memory");
+    return;
+}
+
+struct MicroBenchmarkContext {
+    std::size_t WarmUpRuns;
+    std::size_t Runs;
+
+    template<typename Function>
+    void measure(std::string_view label, Function&& function) const {
+        report(label, calculateStatistics(sampleRuns(WarmUpRuns, Runs, std::forward<Function>(function))));
+        return;
+    }
+
+    void report(std::string_view label, const Statistics& statistics) const;
+};
+
+using MicroBenchmark = void (*)(const MicroBenchmarkContext&);
+
+/**
+ * @brief Registers a micro benchmark, meant for the initialization of a namespace scope variable.
+ */
+bool registerMicroBenchmark(std::string_view name, MicroBenchmark benchmark);
+
+/**
+ * @brief Runs all micro benchmarks with filter in their name, an empty filter runs all.
+ * @return The number of run benchmarks.
+ */
+std::size_t runMicroBenchmarks(std::string_view filter, const MicroBenchmarkContext& context);
+
+namespace std {
+template<>
+struct formatter<Statistics, char> {
+    template<typename Context>
+    constexpr auto parse(Context& ctx) {
+        auto iter = ctx.begin();
+        if ( iter != ctx.end() && *iter != '}' ) {
+            throw std::format_error{"We don't parse!"};
+        } //if ( iter != ctx.end() && *iter != '}' )
+        return iter;
+    }
+
+    template<typename Context>
+    auto format(const Statistics& s, Context& ctx) const {
+        const auto toMicroseconds = [](std::chrono::nanoseconds ns) noexcept {
+            return std::chrono::duration<double, std::micro>{ns}.count();
+        };
+        return std::format_to(ctx.out(),
+                              "min {:.3f}µs, median {:.3f}µs, p95 {:.3f}µs, max {:.3f}µs, "
+                              "stddev {:.3f}µs ({:d} runs)",
+                              toMicroseconds(s.Min), toMicroseconds(s.Median), toMicroseconds(s.P95),
+                              toMicroseconds(s.Max), s.StdDevNs / 1000., s.Runs);
+    }
+};
+} //namespace std
+
+#endif //BENCHMARK_HPP
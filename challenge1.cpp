@@ -68,10 +68,10 @@ std::int64_t countAllZeroes(std::span<const std::string_view> input) {
 } //namespace
 
 bool challenge1(const std::vector<std::string_view>& input) {
-    const auto zeroes = countZeroes(input);
+    const auto zeroes = timePhase("part 1", countZeroes, input);
     myPrint(" == Result of Part 1: {:d} ==\n", zeroes);
 
-    const auto sum2 = countAllZeroes(input);
+    const auto sum2 = timePhase("part 2", countAllZeroes, input);
     myPrint(" == Result of Part 2: {:d} ==\n", sum2);
 
     return zeroes == 1152 && sum2 == 6671;
@@ -1,11 +1,11 @@
 #include "challenge10.hpp"
 
 #include "helper.hpp"
+#include "lineindex.hpp"
 #include "print.hpp"
 
 #include <algorithm>
 #include <flat_map>
-#include <iterator>
 #include <ranges>
 #include <vector>
 
@@ -65,7 +65,7 @@ struct Machine {
 std::vector<Machine> parse(std::span<const std::string_view> input) {
     auto toMachine = [](const std::string_view line) {
         Machine ret;
-        for ( auto section : splitString(line, ' ') ) {
+        for ( auto section : splitIndexed(line, ' ') ) {
             section.remove_suffix(1);
             switch ( section.front() ) {
                 case '[' : {
@@ -76,20 +76,17 @@ std::vector<Machine> parse(std::span<const std::string_view> input) {
                 } //case '['
 
                 case '(' : {
-                    auto& button = ret.Buttons.emplace_back();
-                    std::ranges::transform(splitString(section.substr(1), ','), std::back_inserter(button),
-                                           convert<10>);
+                    parseInts(section.substr(1), ',', ret.Buttons.emplace_back());
                     break;
                 } //case '('
 
                 case '{' : {
-                    std::ranges::transform(splitString(section.substr(1), ','), std::back_inserter(ret.Joltage),
-                                           convert<10>);
+                    parseInts(section.substr(1), ',', ret.Joltage);
                     break;
                 } //case '{'
                 default : throwIfInvalid(false);
             } //switch ( section.front() )
-        } //for ( auto section : splitString(line, ' ') )
+        } //for ( auto section : splitIndexed(line, ' ') )
         return ret;
     };
     return input | std::views::transform(toMachine) | std::ranges::to<std::vector>();
@@ -186,11 +183,15 @@ std::int64_t fewestJoltagePresses(const Machine& machine) noexcept {
 } //namespace
 
 bool challenge10(const std::vector<std::string_view>& input) {
-    const auto machines = parse(input);
-    const auto sum1 = std::ranges::fold_left(machines | std::views::transform(fewestLightPresses), 0, std::plus<>{});
+    const auto machines = timePhase("parse", parse, input);
+    const auto sum1     = timePhase("part 1", [&machines](void) noexcept {
+        return std::ranges::fold_left(machines | std::views::transform(fewestLightPresses), 0, std::plus<>{});
+    });
     myPrint(" == Result of Part 1: {:d} ==\n", sum1);
 
-    const auto sum2 = std::ranges::fold_left(machines | std::views::transform(fewestJoltagePresses), 0, std::plus<>{});
+    const auto sum2 = timePhase("part 2", [&machines](void) noexcept {
+        return std::ranges::fold_left(machines | std::views::transform(fewestJoltagePresses), 0, std::plus<>{});
+    });
     myPrint(" == Result of Part 2: {:d} ==\n", sum2);
 
     return sum1 == 520 && sum2 == 20626;
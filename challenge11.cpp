@@ -57,18 +57,20 @@ std::int64_t countPaths(const Graph& graph, std::string_view current, std::strin
 } //namespace
 
 bool challenge11(const std::vector<std::string_view>& input) {
-    const auto graph            = parse(input);
-    const auto pathCountFromYou = countPaths(graph, "you", "out");
+    const auto graph            = timePhase("parse", parse, input);
+    const auto pathCountFromYou = timePhase("part 1", countPaths, graph, "you", "out");
     myPrint(" == Result of Part 1: {:d} ==\n", pathCountFromYou);
 
-    const auto pathCountFromSvrToDac = countPaths(graph, "svr", "dac");
-    const auto pathCountFromSvrToFft = countPaths(graph, "svr", "fft");
-    const auto pathCountFromDacToFft = countPaths(graph, "dac", "fft");
-    const auto pathCountFromFftToDac = countPaths(graph, "fft", "dac");
-    const auto pathCountFromFftToOut = countPaths(graph, "fft", "out");
-    const auto pathCountFromDacToOut = countPaths(graph, "dac", "out");
-    const auto pathCountFromSvr      = pathCountFromSvrToDac * pathCountFromDacToFft * pathCountFromFftToOut +
-                                       pathCountFromSvrToFft * pathCountFromFftToDac * pathCountFromDacToOut;
+    const auto pathCountFromSvr = timePhase("part 2", [&graph](void) {
+        const auto pathCountFromSvrToDac = countPaths(graph, "svr", "dac");
+        const auto pathCountFromSvrToFft = countPaths(graph, "svr", "fft");
+        const auto pathCountFromDacToFft = countPaths(graph, "dac", "fft");
+        const auto pathCountFromFftToDac = countPaths(graph, "fft", "dac");
+        const auto pathCountFromFftToOut = countPaths(graph, "fft", "out");
+        const auto pathCountFromDacToOut = countPaths(graph, "dac", "out");
+        return pathCountFromSvrToDac * pathCountFromDacToFft * pathCountFromFftToOut +
+               pathCountFromSvrToFft * pathCountFromFftToDac * pathCountFromDacToOut;
+    });
     myPrint(" == Result of Part 2: {:d} ==\n", pathCountFromSvr);
 
     return pathCountFromYou == 497 && pathCountFromSvr == 358'564'784'931'864;
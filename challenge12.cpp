@@ -213,9 +213,11 @@ bool fits(const Tree& tree, const std::array<std::flat_set<Present>, NumberOfPre
 } //namespace
 
 bool challenge12(const std::vector<std::string_view>& input) {
-    const auto problem = parse(input);
-    const auto count   = std::ranges::count_if(
-        problem.Trees, [&problem](const Tree& tree) noexcept { return fits(tree, problem.Presents); });
+    const auto problem = timePhase("parse", parse, input);
+    const auto count   = timePhase("part 1", [&problem](void) noexcept {
+        return std::ranges::count_if(problem.Trees,
+                                     [&problem](const Tree& tree) noexcept { return fits(tree, problem.Presents); });
+    });
     myPrint(" == Result of Part 1: {:d} ==\n", count);
 
     return count == 479;
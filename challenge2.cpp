@@ -1,10 +1,10 @@
 #include "challenge2.hpp"
 
 #include "helper.hpp"
+#include "lineindex.hpp"
 #include "print.hpp"
 
 #include <algorithm>
-#include <unordered_set>
 
 namespace {
 struct IdRange {
@@ -14,7 +14,7 @@ struct IdRange {
 
 auto toRanges(std::span<const std::string_view> input) {
     throwIfInvalid(input.size() == 1);
-    return splitString(input.front(), ',') | std::views::transform([](std::string_view range) {
+    return splitIndexed(input.front(), ',') | std::views::transform([](std::string_view range) {
                auto dash = range.find('-');
                throwIfInvalid(dash != std::string_view::npos);
                return IdRange{range.substr(0, dash), range.substr(dash + 1)};
@@ -70,7 +70,7 @@ std::int64_t sumInvalidIdsPart2(const IdRange& range) {
     const auto lowest  = convert(range.Lower);
     const auto highest = convert(range.Upper);
 
-    std::unordered_set<std::int64_t> invalidIds;
+    FlatHashSet<std::int64_t> invalidIds;
     for ( auto value = from; value <= to; ++value ) {
         const auto length = log10(value);
         const auto shift  = pow(10, length + 1);
@@ -87,12 +87,14 @@ std::int64_t sumInvalidIdsPart2(const IdRange& range) {
 } //namespace
 
 bool challenge2(const std::vector<std::string_view>& input) {
-    const auto sum1 =
-        std::ranges::fold_left(toRanges(input) | std::views::transform(sumInvalidIds), 0, std::plus<>{});
+    const auto sum1 = timePhase("part 1", [&input](void) {
+        return std::ranges::fold_left(toRanges(input) | std::views::transform(sumInvalidIds), 0, std::plus<>{});
+    });
     myPrint(" == Result of Part 1: {:d} ==\n", sum1);
 
-    const auto sum2 =
-        std::ranges::fold_left(toRanges(input) | std::views::transform(sumInvalidIdsPart2), 0, std::plus<>{});
+    const auto sum2 = timePhase("part 2", [&input](void) {
+        return std::ranges::fold_left(toRanges(input) | std::views::transform(sumInvalidIdsPart2), 0, std::plus<>{});
+    });
     myPrint(" == Result of Part 2: {:d} ==\n", sum2);
 
     return sum1 == 15'873'079'081 && sum2 == 22'617'871'034;
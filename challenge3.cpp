@@ -29,10 +29,14 @@ std::int64_t findLargestBatterySum12(std::string_view bank) {
 } //namespace
 
 bool challenge3(const std::vector<std::string_view>& input) {
-    const auto sum1 = std::ranges::fold_left(input | std::views::transform(findLargestBatterySum2), 0, std::plus<>{});
+    const auto sum1 = timePhase("part 1", [&input](void) {
+        return std::ranges::fold_left(input | std::views::transform(findLargestBatterySum2), 0, std::plus<>{});
+    });
     myPrint(" == Result of Part 1: {:d} ==\n", sum1);
 
-    const auto sum2 = std::ranges::fold_left(input | std::views::transform(findLargestBatterySum12), 0, std::plus<>{});
+    const auto sum2 = timePhase("part 2", [&input](void) {
+        return std::ranges::fold_left(input | std::views::transform(findLargestBatterySum12), 0, std::plus<>{});
+    });
     myPrint(" == Result of Part 2: {:d} ==\n", sum2);
 
     return sum1 == 16842 && sum2 == 20520794;
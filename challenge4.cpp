@@ -1,45 +1,54 @@
 #include "challenge4.hpp"
 
+#include "grid.hpp"
 #include "helper.hpp"
 #include "print.hpp"
 
 #include <algorithm>
-#include <iterator>
-#include <unordered_set>
 
 namespace {
-auto countFreeRolls(MapView map) {
-    auto isRoll     = [map](Coordinate<std::int64_t> c) noexcept { return map[c] == '@'; };
-    auto isFreeRoll = [&isRoll](Coordinate<std::int64_t> c) noexcept {
-        return isRoll(c) && std::ranges::count_if(c.validNeighborsWithDiagnonal(), isRoll) < 4;
-    };
-    return std::ranges::count_if(Coordinate<std::int64_t>::allPositions(), isFreeRoll);
+constexpr char Roll  = '@';
+constexpr char Empty = '.';
+
+bool isFreeRoll(const Grid<char>& grid, Grid<char>::Index index) noexcept {
+    if ( grid[index] != Roll ) {
+        return false;
+    } //if ( grid[index] != Roll )
+    const auto offsets = grid.neighborOffsetsWithDiagonal();
+    return std::ranges::count_if(offsets, [&grid, index](Grid<char>::Index offset) noexcept {
+               return grid[index + offset] == Roll;
+           }) < 4;
+}
+
+auto countFreeRolls(const Grid<char>& grid) {
+    return std::ranges::count_if(grid.indices(), [&grid](Grid<char>::Index index) noexcept {
+        return isFreeRoll(grid, index);
+    });
 }
 
-auto countRepeadetelyFreeRolls(MapView map) {
-    std::unordered_set<Coordinate<std::int64_t>> freedPositions;
-    auto                                         oldSize = freedPositions.size();
-    auto                                         isRoll  = [map, &freedPositions](Coordinate<std::int64_t> c) noexcept {
-        return map[c] == '@' && !freedPositions.contains(c);
-    };
-    auto isFreeRoll = [&isRoll](Coordinate<std::int64_t> c) noexcept {
-        return isRoll(c) && std::ranges::count_if(c.validNeighborsWithDiagnonal(), isRoll) < 4;
-    };
+auto countRepeadetelyFreeRolls(Grid<char> grid) {
+    std::int64_t freed = 0;
+    std::int64_t freedThisRound;
     do {
-        std::ranges::copy(Coordinate<std::int64_t>::allPositions() | std::views::filter(isFreeRoll),
-                          std::inserter(freedPositions, freedPositions.end()));
-    } while ( std::exchange(oldSize, freedPositions.size()) != freedPositions.size() );
-    return oldSize;
+        freedThisRound = 0;
+        for ( const auto index : grid.indices() ) {
+            if ( isFreeRoll(grid, index) ) {
+                grid[index] = Empty;
+                ++freedThisRound;
+            } //if ( isFreeRoll(grid, index) )
+        } //for ( const auto index : grid.indices() )
+        freed += freedThisRound;
+    } while ( freedThisRound != 0 );
+    return freed;
 }
 } //namespace
 
 bool challenge4(const std::vector<std::string_view>& input) {
-    MapView map{input};
-    Coordinate<std::int64_t>::setMaxFromMap(map);
-    const auto sum1 = countFreeRolls(map);
+    const auto grid = timePhase("parse", [&input](void) { return Grid<char>::fromLines(input, Empty); });
+    const auto sum1 = timePhase("part 1", countFreeRolls, grid);
     myPrint(" == Result of Part 1: {:d} ==\n", sum1);
 
-    const auto sum2 = countRepeadetelyFreeRolls(map);
+    const auto sum2 = timePhase("part 2", countRepeadetelyFreeRolls, grid);
     myPrint(" == Result of Part 2: {:d} ==\n", sum2);
 
     return sum1 == 1411 && sum2 == 20520794;
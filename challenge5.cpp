@@ -68,12 +68,14 @@ std::int64_t countFresh(const Database& database) noexcept {
 } //namespace
 
 bool challenge5(const std::vector<std::string_view>& input) {
-    const auto database = parse(input);
-    const auto sum1     = countFresh(database);
+    const auto database = timePhase("parse", parse, input);
+    const auto sum1     = timePhase("part 1", countFresh, database);
     myPrint(" == Result of Part 1: {:d} ==\n", sum1);
 
-    const auto sum2 =
-        std::ranges::fold_left(database.FreshIngredients | std::views::transform(&Range::size), 0, std::plus<>{});
+    const auto sum2 = timePhase("part 2", [&database](void) noexcept {
+        return std::ranges::fold_left(database.FreshIngredients | std::views::transform(&Range::size), 0,
+                                      std::plus<>{});
+    });
     myPrint(" == Result of Part 2: {:d} ==\n", sum2);
 
     return sum1 == 775 && sum2 == 350'684'792'662'845;
@@ -1,6 +1,8 @@
 #include "challenge6.hpp"
 
+#include "grid.hpp"
 #include "helper.hpp"
+#include "lineindex.hpp"
 #include "print.hpp"
 
 #include <algorithm>
@@ -24,7 +26,7 @@ Math parse(std::span<const std::string_view> input) {
     Math ret;
 
     auto addToNumbers = [&ret](std::string_view line) {
-        std::ranges::for_each(std::views::zip(splitString(line, ' '), ret.Problems),
+        std::ranges::for_each(std::views::zip(splitIndexed(line, ' '), ret.Problems),
                               [](std::tuple<std::string_view, Problem&> numberAndProblem) {
                                   auto&& [number, problem] = numberAndProblem;
                                   problem.Numbers.push_back(convert(number));
@@ -33,7 +35,7 @@ Math parse(std::span<const std::string_view> input) {
         return;
     };
 
-    std::ranges::transform(splitString(input.back(), ' '), std::back_inserter(ret.Problems), [](std::string_view op) {
+    std::ranges::transform(splitIndexed(input.back(), ' '), std::back_inserter(ret.Problems), [](std::string_view op) {
         throwIfInvalid(op.size() == 1);
         return Problem{{}, static_cast<Operation>(op.front())};
     });
@@ -41,21 +43,21 @@ Math parse(std::span<const std::string_view> input) {
     return ret;
 }
 
-void reparseFancy(Math& math, MapView map) {
-    using Coordinate = ::Coordinate<std::int64_t>;
-    Coordinate::setMaxFromMap(map);
-    Coordinate lastSpacer{Coordinate::MaxRow - 1, -1};
+void reparseFancy(Math& math, std::span<const std::string_view> input) {
+    using Coordinate = Grid<char>::Coordinate;
+    //The border is no space, so the scan for the next operator stops there without a bounds check.
+    const auto map = Grid<char>::fromLines(input, '\0');
+    Coordinate lastSpacer{map.rows() - 1, -1};
 
     auto reparse = [&lastSpacer, &map](Problem& problem) {
         problem.Numbers.clear();
         auto nextSpacer = lastSpacer.right();
-        for ( nextSpacer.move(Direction::Right); nextSpacer.isValid() && map[nextSpacer] == ' ';
-              nextSpacer.move(Direction::Right) ) {
+        for ( nextSpacer.move(Direction::Right); map[nextSpacer] == ' '; nextSpacer.move(Direction::Right) ) {
         } //for ( nextSpacer.move(Direction::Right); map[nextSpacer] == ' '; nextSpacer.move(Direction::Right) )
 
-        if ( nextSpacer.isValid() ) {
+        if ( map.contains(nextSpacer) ) {
             nextSpacer.move(Direction::Left);
-        } //if ( nextSpacer.isValid() )
+        } //if ( map.contains(nextSpacer) )
         for ( Coordinate numberStart{0, nextSpacer.Column - 1}; numberStart.Column != lastSpacer.Column;
               numberStart.move(Direction::Left) ) {
             std::int64_t& number = problem.Numbers.emplace_back(0);
@@ -90,12 +92,15 @@ std::int64_t solveProblem(const Problem& problem) noexcept {
 } //namespace
 
 bool challenge6(const std::vector<std::string_view>& input) {
-    auto       math = parse(input);
-    const auto sum1 = std::ranges::fold_left(math.Problems | std::views::transform(solveProblem), 0, std::plus<>{});
+    auto       math  = timePhase("parse", parse, input);
+    const auto solve = [&math](void) noexcept {
+        return std::ranges::fold_left(math.Problems | std::views::transform(solveProblem), 0, std::plus<>{});
+    };
+    const auto sum1 = timePhase("part 1", solve);
     myPrint(" == Result of Part 1: {:d} ==\n", sum1);
 
-    reparseFancy(math, input);
-    const auto sum2 = std::ranges::fold_left(math.Problems | std::views::transform(solveProblem), 0, std::plus<>{});
+    timePhase("reparse", reparseFancy, math, input);
+    const auto sum2 = timePhase("part 2", solve);
     myPrint(" == Result of Part 2: {:d} ==\n", sum2);
 
     return sum1 == 6'605'396'225'322 && sum2 == 11'052'310'600'986;
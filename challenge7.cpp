@@ -1,47 +1,58 @@
 #include "challenge7.hpp"
 
+#include "grid.hpp"
 #include "helper.hpp"
 #include "print.hpp"
 
 #include <algorithm>
-#include <flat_map>
 #include <flat_set>
 
 namespace {
-using Coordinate = Coordinate<std::int64_t>;
+using Index             = Grid<char>::Index;
 
-std::int64_t countSplits(MapView map) {
-    Coordinate::setMaxFromMap(map);
-    const auto startColumn = map.Base.front().find('S');
-    throwIfInvalid(startColumn != std::string_view::npos);
+constexpr char Outside  = '\0';
+constexpr char Empty    = '.';
+constexpr char Splitter = '^';
 
-    std::flat_set<Coordinate> beams;
-    std::flat_set<Coordinate> nextBeams;
-    std::int64_t              numberOfSplits = 0;
+Index findStart(const Grid<char>& map) {
+    const auto firstRow    = map.row(0);
+    const auto startColumn = std::ranges::find(firstRow, 'S') - firstRow.begin();
+    throwIfInvalid(startColumn != std::ssize(firstRow));
+    return map.index({0, startColumn});
+}
+
+std::int64_t countSplits(const Grid<char>& map) {
+    const auto down  = map.offset(Direction::Down);
+    const auto left  = map.offset(Direction::Left);
+    const auto right = map.offset(Direction::Right);
+
+    std::flat_set<Index> beams;
+    std::flat_set<Index> nextBeams;
+    std::int64_t         numberOfSplits = 0;
 
-    auto addIfValid                          = [&nextBeams](Coordinate beam) noexcept {
-        if ( beam.isValid() ) {
+    auto addIfInside                    = [&map, &nextBeams](Index beam) noexcept {
+        if ( map[beam] != Outside ) {
             nextBeams.insert(beam);
-        } //if ( beam.isValid() )
+        } //if ( map[beam] != Outside )
         return;
     };
 
-    beams.emplace(0, static_cast<std::int64_t>(startColumn));
+    beams.insert(findStart(map));
 
     while ( !beams.empty() ) {
         for ( auto beam : beams ) {
-            beam.move(Direction::Down);
-            if ( beam.isValid() ) {
-                if ( map[beam] == '.' ) {
-                    nextBeams.insert(beam);
-                } //if ( map[beam] == '.' )
-                else {
-                    throwIfInvalid(map[beam] == '^');
+            beam += down;
+            switch ( map[beam] ) {
+                case Empty    : nextBeams.insert(beam); break;
+                case Outside  : break;
+                case Splitter : {
                     ++numberOfSplits;
-                    addIfValid(beam.moved(Direction::Left));
-                    addIfValid(beam.moved(Direction::Right));
-                } //else -> if ( map[beam] == '.' )
-            } //if ( beam.isValid() )
+                    addIfInside(beam + left);
+                    addIfInside(beam + right);
+                    break;
+                } //case Splitter
+                default : throwIfInvalid(false);
+            } //switch ( map[beam] )
         } //for ( auto beam : beams )
         std::swap(beams, nextBeams);
         nextBeams.clear();
@@ -50,40 +61,49 @@ std::int64_t countSplits(MapView map) {
     return numberOfSplits;
 }
 
-std::int64_t countTimelines(MapView map, Coordinate beam) noexcept {
-    beam.move(Direction::Down);
-    if ( !beam.isValid() ) {
-        return 1;
-    } //if ( !beam.isValid() )
-
-    static std::flat_map<Coordinate, std::int64_t> cache;
-    if ( auto iter = cache.find(beam); iter != cache.end() ) {
-        return iter->second;
-    } //if ( auto iter = cache.find(beam); iter != cache.end() )
-
-    std::int64_t ret = 0;
-    if ( map[beam] == '.' ) {
-        ret = countTimelines(map, beam);
-    } //if ( map[beam] == '.' )
-    else {
-        ret = countTimelines(map, beam.moved(Direction::Left)) + countTimelines(map, beam.moved(Direction::Right));
-    } //else -> if ( map[beam] == '.' )
-
-    cache.emplace(beam, ret);
-    return ret;
-}
-
-std::int64_t countTimelines(MapView map) noexcept {
-    const auto startColumn = map.Base.front().find('S');
-    return countTimelines(map, Coordinate{0, static_cast<std::int64_t>(startColumn)});
+struct TimelineCounter {
+    const Grid<char>&  Map;
+    Grid<std::int64_t> Cache;
+    Index              Down;
+    Index              Left;
+    Index              Right;
+
+    explicit TimelineCounter(const Grid<char>& map) :
+            //A beam leaving the map is one timeline, so the border is already cached as 1.
+            Map{map}, Cache{map.rows(), map.columns(), -1, 1, map.padding()}, Down{map.offset(Direction::Down)},
+            Left{map.offset(Direction::Left)}, Right{map.offset(Direction::Right)} {
+        return;
+    }
+
+    std::int64_t count(Index beam) noexcept {
+        beam       += Down;
+        auto& cache = Cache[beam];
+        if ( cache != -1 ) {
+            return cache;
+        } //if ( cache != -1 )
+
+        if ( Map[beam] == Empty ) {
+            cache = count(beam);
+        } //if ( Map[beam] == Empty )
+        else {
+            cache = count(beam + Left) + count(beam + Right);
+        } //else -> if ( Map[beam] == Empty )
+        return cache;
+    }
+};
+
+std::int64_t countTimelines(const Grid<char>& map) {
+    TimelineCounter counter{map};
+    return counter.count(findStart(map));
 }
 } //namespace
 
 bool challenge7(const std::vector<std::string_view>& input) {
-    const auto numberOfSplits = countSplits(input);
+    const auto map            = timePhase("parse", [&input](void) { return Grid<char>::fromLines(input, Outside); });
+    const auto numberOfSplits = timePhase("part 1", countSplits, map);
     myPrint(" == Result of Part 1: {:d} ==\n", numberOfSplits);
 
-    const auto numberOfTimelines = countTimelines(input);
+    const auto numberOfTimelines = timePhase("part 2", countTimelines, map);
     myPrint(" == Result of Part 2: {:d} ==\n", numberOfTimelines);
 
     return numberOfSplits == 1570 && numberOfTimelines == 15'118'009'521'693;
@@ -2,126 +2,308 @@
 
 #include "coordinate3d.hpp"
 #include "helper.hpp"
+#include "kdtree.hpp"
+#include "pointcloud.hpp"
 #include "print.hpp"
+#include "threadpool.hpp"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
+#include <limits>
 #include <ranges>
+#include <span>
 #include <vector>
 
 namespace {
 struct JunctionBox {
     Coordinate3D<std::int64_t> Coordinate;
-    std::int64_t               Circuit = -1;
+};
+
+struct Distance {
+    //Only the order matters, so there is no need to take the root.
+    std::uint64_t SquaredDistance;
+    std::size_t   Index1;
+    std::size_t   Index2;
+};
+
+/**
+ * @brief The edges from every box to its k nearest neighbors, which contain the short edges of the complete graph.
+ *
+ * An edge (i, j) which is no candidate is at least as long as the k-th neighbor of i and the one of j, which is what
+ * the exactness checks of Problem build upon. If one fails, k is doubled, at most until all edges are candidates.
+ *
+ * The candidates are yielded lazily, the shortest first. They are sorted in batches of growing size, each selected by
+ * nth_element from the rest, so the few shortest edges part 1 needs do not pay for sorting all of them.
+ */
+class CandidateEdges {
+    public:
+    /**
+     * @param pool Runs the neighbor queries, it has to outlive the candidates.
+     */
+    CandidateEdges(std::span<const JunctionBox> boxes, ThreadPool& pool) :
+            Pool{&pool}, Points{toPointCloud(boxes)}, Tree{Points} {
+        compute(std::min(InitialNeighbors, Points.size() - 1));
+        return;
+    }
+
+    bool isComplete(void) const noexcept {
+        return K + 1 >= Points.size();
+    }
+
+    /**
+     * @brief Doubles k, returns false if all edges already are candidates.
+     */
+    bool widen(void) {
+        if ( isComplete() ) {
+            return false;
+        } //if ( isComplete() )
+        compute(std::min(2 * K, Points.size() - 1));
+        return true;
+    }
+
+    /**
+     * @brief The squared distance to the k-th neighbor, every edge of index which is no candidate is at least as long.
+     */
+    std::uint64_t radius(std::size_t index) const noexcept {
+        return Radius[index];
+    }
+
+    bool isCandidate(std::size_t index1, std::size_t index2) const noexcept {
+        return std::ranges::contains(neighborsOf(index1), index2, &KdTree::Neighbor::Index) ||
+               std::ranges::contains(neighborsOf(index2), index1, &KdTree::Neighbor::Index);
+    }
+
+    void within(std::size_t index, std::uint64_t limit, std::vector<KdTree::Neighbor>& out) const {
+        Tree.within(index, limit, out);
+        return;
+    }
+
+    /**
+     * @brief Starts over to yield all candidates, each once, the shortest first.
+     */
+    void rewind(void) {
+        Edges.clear();
+        Edges.reserve(Neighbors.size());
+        for ( std::size_t index = 0; index < Points.size(); ++index ) {
+            for ( const auto& neighbor : neighborsOf(index) ) {
+                //From the lower index, or from the only end, which has the other as neighbor.
+                if ( index < neighbor.Index ||
+                     !std::ranges::contains(neighborsOf(neighbor.Index), index, &KdTree::Neighbor::Index) ) {
+                    Edges.push_back({neighbor.SquaredDistance, index, neighbor.Index});
+                } //if ( index < neighbor.Index || ... )
+            } //for ( const auto& neighbor : neighborsOf(index) )
+        } //for ( std::size_t index = 0; index < Points.size(); ++index )
+        Next   = 0;
+        Sorted = 0;
+        return;
+    }
+
+    bool hasNext(void) const noexcept {
+        return Next < Edges.size();
+    }
+
+    Distance next(void) {
+        if ( Next == Sorted ) {
+            //Double the sorted part, the rest stays unordered behind it.
+            const auto first = Edges.begin() + static_cast<std::ptrdiff_t>(Sorted);
+            Sorted           = std::min(Sorted + std::max(Sorted, InitialBatch), Edges.size());
+            const auto last  = Edges.begin() + static_cast<std::ptrdiff_t>(Sorted);
+            std::ranges::nth_element(first, last, Edges.end(), {}, &Distance::SquaredDistance);
+            std::ranges::sort(first, last, {}, &Distance::SquaredDistance);
+        } //if ( Next == Sorted )
+        return Edges[Next++];
+    }
+
+    private:
+    static constexpr std::size_t InitialNeighbors = 16;
+    static constexpr std::size_t InitialBatch     = 1024;
+
+    ThreadPool*                   Pool;
+    PointCloud                    Points;
+    KdTree                        Tree;
+    std::size_t                   K = 0;
+    std::vector<KdTree::Neighbor> Neighbors;
+    std::vector<std::uint64_t>    Radius;
+    std::vector<Distance>         Edges;
+    std::size_t                   Next   = 0;
+    std::size_t                   Sorted = 0;
+
+    static PointCloud toPointCloud(std::span<const JunctionBox> boxes) {
+        PointCloud ret;
+        ret.reserve(boxes.size());
+        for ( const auto& box : boxes ) {
+            ret.push_back(box.Coordinate);
+        } //for ( const auto& box : boxes )
+        return ret;
+    }
+
+    std::span<const KdTree::Neighbor> neighborsOf(std::size_t index) const noexcept {
+        return std::span{Neighbors}.subspan(index * K, K);
+    }
+
+    void compute(std::size_t k) {
+        K = k;
+        Neighbors.resize(Points.size() * K);
+        Radius.resize(Points.size());
+
+        Tree.nearestOfAll(K, Neighbors, *Pool);
+        for ( std::size_t index = 0; index < Points.size(); ++index ) {
+            Radius[index] =
+                isComplete() ? std::numeric_limits<std::uint64_t>::max() : neighborsOf(index).back().SquaredDistance;
+        } //for ( std::size_t index = 0; index < Points.size(); ++index )
+        rewind();
+        return;
+    }
 };
 
 struct Problem {
-    struct Distance {
-        double      Distance;
-        std::size_t Index1;
-        std::size_t Index2;
-    };
+    std::vector<JunctionBox> Boxes;
+    CandidateEdges           Candidates;
+    DisjointSet              Circuits;
+    std::int64_t             ProductOfLastConnection = 0;
+
+    Problem(std::vector<JunctionBox> boxes, ThreadPool& pool) :
+            Boxes{std::move(boxes)}, Candidates{Boxes, pool}, Circuits{Boxes.size()} {
+        return;
+    }
+
+    void connect(const Distance& edge) noexcept {
+        const auto [_, i1, i2] = edge;
+        if ( Circuits.unite(i1, i2) ) {
+            ProductOfLastConnection = Boxes[i1].Coordinate.X * Boxes[i2].Coordinate.X;
+        } //if ( Circuits.unite(i1, i2) )
+        return;
+    }
+
+    /**
+     * @brief Whether the shortest candidates are the count shortest edges of the complete graph.
+     */
+    bool shortestAreExact(std::span<const Distance> shortest, std::size_t count) const {
+        if ( shortest.size() < count ) {
+            return Candidates.isComplete();
+        } //if ( shortest.size() < count )
+        if ( count == 0 ) {
+            return true;
+        } //if ( count == 0 )
+
+        //A missing edge shorter than the limit needs both its ends to have a k-th neighbor closer than the limit.
+        const auto                    limit = shortest.back().SquaredDistance;
+        std::vector<KdTree::Neighbor> close;
+        for ( std::size_t index = 0; index < Boxes.size(); ++index ) {
+            if ( Candidates.radius(index) >= limit ) {
+                continue;
+            } //if ( Candidates.radius(index) >= limit )
+
+            Candidates.within(index, limit, close);
+            if ( !std::ranges::all_of(close, [this, index](const KdTree::Neighbor& neighbor) noexcept {
+                     return Candidates.isCandidate(index, neighbor.Index);
+                 }) ) {
+                return false;
+            } //if ( !std::ranges::all_of(close, ...) )
+        } //for ( std::size_t index = 0; index < Boxes.size(); ++index )
+        return true;
+    }
+
+    /**
+     * @brief Whether no edge between the two last circuits is shorter than last, which is about to join them.
+     */
+    bool lastConnectionIsExact(const Distance& last) {
+        const auto first   = Circuits.find(last.Index1);
+        const auto inFirst = [this, first](std::size_t index) noexcept { return Circuits.find(index) == first; };
 
-    std::vector<JunctionBox>  Boxes;
-    std::vector<std::int64_t> CircuitSize;
-    std::vector<Distance>     Distances;
-    std::int64_t              ProductOfLastConnection;
-
-    void connect(void) noexcept {
-        auto [_, i1, i2]       = Distances.back();
-        auto&      b1          = Boxes[i1];
-        auto&      b2          = Boxes[i2];
-        const auto hasCircuit1 = b1.Circuit != -1;
-        const auto hasCircuit2 = b2.Circuit != -1;
-        Distances.pop_back();
-
-        if ( !hasCircuit1 && !hasCircuit2 ) {
-            const auto circuit = CircuitSize.size();
-            b1.Circuit = b2.Circuit = static_cast<std::int64_t>(circuit);
-            CircuitSize.emplace_back(2);
-            ProductOfLastConnection = b1.Coordinate.X * b2.Coordinate.X;
-        } //if ( !hasCircuit1 && !hasCircuit2 )
-        else if ( hasCircuit1 && !hasCircuit2 ) {
-            b2.Circuit = b1.Circuit;
-            ++CircuitSize[static_cast<std::size_t>(b1.Circuit)];
-            ProductOfLastConnection = b1.Coordinate.X * b2.Coordinate.X;
-        } //else if ( hasCircuit1 && !hasCircuit2 )
-        else if ( !hasCircuit1 && hasCircuit2 ) {
-            b1.Circuit = b2.Circuit;
-            ++CircuitSize[static_cast<std::size_t>(b1.Circuit)];
-            ProductOfLastConnection = b1.Coordinate.X * b2.Coordinate.X;
-        } //else if ( !hasCircuit1 && hasCircuit2 )
-        else if ( b1.Circuit != b2.Circuit ) {
-            CircuitSize[static_cast<std::size_t>(b1.Circuit)] +=
-                std::exchange(CircuitSize[static_cast<std::size_t>(b2.Circuit)], 0);
-            const auto hasB2Circuit = [b2](const JunctionBox& box) noexcept { return box.Circuit == b2.Circuit; };
-            for ( auto& box : Boxes | std::views::filter(hasB2Circuit) ) {
-                box.Circuit = b1.Circuit;
-            } //for ( auto& box : Boxes | std::views::filter(hasB2Circuit) )
-            ProductOfLastConnection = b1.Coordinate.X * b2.Coordinate.X;
-        } //else if ( b1.Circuit != b2.Circuit )
+        //A missing edge between them has to be found from either side, so check the smaller one.
+        const bool                    checkFirst = 2 * Circuits.sizeOf(first) <= Boxes.size();
+        std::vector<KdTree::Neighbor> close;
+        for ( std::size_t index = 0; index < Boxes.size(); ++index ) {
+            if ( inFirst(index) != checkFirst || Candidates.radius(index) >= last.SquaredDistance ) {
+                continue;
+            } //if ( inFirst(index) != checkFirst || Candidates.radius(index) >= last.SquaredDistance )
+
+            Candidates.within(index, last.SquaredDistance, close);
+            if ( std::ranges::any_of(close, [&inFirst, checkFirst](const KdTree::Neighbor& neighbor) noexcept {
+                     return inFirst(neighbor.Index) != checkFirst;
+                 }) ) {
+                return false;
+            } //if ( std::ranges::any_of(close, ...) )
+        } //for ( std::size_t index = 0; index < Boxes.size(); ++index )
+        return true;
+    }
+
+    void reset(void) {
+        Circuits = DisjointSet{Boxes.size()};
+        Candidates.rewind();
         return;
     }
 
-    std::int64_t connectShortest(int connections) noexcept {
-        for ( ; connections; --connections ) {
-            connect();
-        } //for ( ; connections; --connections )
+    std::int64_t connectShortest(std::size_t connections) {
+        std::vector<Distance> shortest;
+        shortest.reserve(connections);
+        do {
+            shortest.clear();
+            while ( shortest.size() < connections && Candidates.hasNext() ) {
+                shortest.push_back(Candidates.next());
+            } //while ( shortest.size() < connections && Candidates.hasNext() )
+        } while ( !shortestAreExact(shortest, connections) && Candidates.widen() );
+
+        for ( const auto& edge : shortest ) {
+            connect(edge);
+        } //for ( const auto& edge : shortest )
+
+        auto sizes = Circuits.componentSizes();
+        std::ranges::nth_element(sizes, std::next(sizes.begin(), std::min(3z, std::ssize(sizes))),
+                                 std::ranges::greater{});
+        const auto toSigned = [](std::size_t size) noexcept { return static_cast<std::int64_t>(size); };
+        return std::ranges::fold_left(sizes | std::views::take(3) | std::views::transform(toSigned), std::int64_t{1},
+                                      std::multiplies<>{});
+    }
 
-        auto temp = CircuitSize;
-        std::ranges::nth_element(temp, std::next(temp.begin(), 3), std::ranges::greater{});
-        return std::ranges::fold_left(temp | std::views::take(3), 1, std::multiplies<>{});
+    /**
+     * @brief Connects until all boxes are in one circuit, returns whether the last connection is the exact one.
+     */
+    bool connectUntilOneCircuit(void) {
+        while ( Candidates.hasNext() && Circuits.components() > 1 ) {
+            const auto next = Candidates.next();
+            if ( Circuits.components() == 2 && !Circuits.connected(next.Index1, next.Index2) ) {
+                const auto exact = lastConnectionIsExact(next);
+                connect(next);
+                return exact;
+            } //if ( Circuits.components() == 2 && !Circuits.connected(next.Index1, next.Index2) )
+            connect(next);
+        } //while ( Candidates.hasNext() && Circuits.components() > 1 )
+        return false;
     }
 
-    void keepConnecting(void) noexcept {
-        while ( !Distances.empty() ) {
-            connect();
-        } //while ( !Distances.empty() )
+    void keepConnecting(void) {
+        while ( !connectUntilOneCircuit() ) {
+            //When part 1 already joined all boxes, the last connection is unknown and it has to start over anyway.
+            Candidates.widen();
+            reset();
+        } //while ( !connectUntilOneCircuit() )
         return;
     }
 };
 
-Problem parse(std::span<const std::string_view> input) {
-    Problem ret;
-    auto    toBox = [](std::string_view line) {
-        auto numbers = splitString(line, ',');
-        auto iter    = numbers.begin();
-        throwIfInvalid(iter != numbers.end());
-        auto x = convert(*iter);
-        throwIfInvalid(iter != numbers.end());
-        auto y = convert(*++iter);
-        throwIfInvalid(iter != numbers.end());
-        auto z = convert(*++iter);
-        throwIfInvalid(++iter == numbers.end());
-        return JunctionBox{{x, y, z}, -1};
+Problem parse(std::span<const std::string_view> input, ThreadPool& pool) {
+    std::vector<JunctionBox> boxes;
+    auto                     toBox = [](std::string_view line) {
+        std::array<std::int64_t, 3> numbers{};
+        throwIfInvalid(parseInts(line, ',', numbers) == 3);
+        return JunctionBox{{numbers[0], numbers[1], numbers[2]}};
     };
-    std::ranges::transform(input, std::back_inserter(ret.Boxes), toBox);
-    const auto indices = std::views::iota(0uz, ret.Boxes.size());
-    ret.Distances      = std::views::cartesian_product(indices, indices) |
-                    std::views::filter([](const std::tuple<std::size_t, std::size_t>& tuple) noexcept {
-                        return std::get<0>(tuple) > std::get<1>(tuple);
-                    }) |
-                    std::views::transform([ret](const std::tuple<std::size_t, std::size_t>& tuple) noexcept {
-                        const auto i1 = std::get<0>(tuple);
-                        const auto i2 = std::get<1>(tuple);
-                        const auto c1 = ret.Boxes[i1].Coordinate;
-                        const auto c2 = ret.Boxes[i2].Coordinate;
-                        return Problem::Distance{(c1 - c2).length(), i1, i2};
-                    }) |
-                    std::ranges::to<std::vector>();
-
-    std::ranges::sort(ret.Distances, std::ranges::greater{}, &Problem::Distance::Distance);
-
-    return ret;
+    std::ranges::transform(input, std::back_inserter(boxes), toBox);
+    throwIfInvalid(boxes.size() >= 2);
+    return Problem{std::move(boxes), pool};
 }
 } //namespace
 
 bool challenge8(const std::vector<std::string_view>& input) {
-    auto       problem  = parse(input);
-    const auto product1 = problem.connectShortest(1000);
+    ThreadPool pool{threadsPerJob()};
+    auto       problem  = timePhase("parse", parse, input, pool);
+    const auto product1 = timePhase("part 1", [&problem](void) { return problem.connectShortest(1000); });
     myPrint(" == Result of Part 1: {:d} ==\n", product1);
 
-    problem.keepConnecting();
+    timePhase("part 2", &Problem::keepConnecting, problem);
     const auto product2 = problem.ProductOfLastConnection;
     myPrint(" == Result of Part 2: {:d} ==\n", product2);
 
@@ -1,23 +1,18 @@
 #include "challenge9.hpp"
 
+#include "grid.hpp"
 #include "helper.hpp"
 #include "print.hpp"
 
 #include <algorithm>
-#include <flat_set>
 #include <ranges>
+#include <span>
 #include <vector>
 
 namespace {
 using Coordinate = Coordinate<std::int64_t>;
 using List       = std::vector<Coordinate>;
 
-struct Rectangle {
-    Coordinate   C1;
-    Coordinate   C2;
-    std::int64_t Area;
-};
-
 List parse(std::span<const std::string_view> input) {
     return input | std::views::transform([](std::string_view line) {
                const auto comma = line.find(',');
@@ -27,476 +22,196 @@ List parse(std::span<const std::string_view> input) {
            std::ranges::to<std::vector>();
 }
 
-std::vector<Rectangle> calculateRectangles(const List& list) noexcept {
-    auto calcArea = [](const std::tuple<Coordinate, Coordinate>& tuple) noexcept {
-        auto [c1, c2] = tuple;
-        if ( c2.Row < c1.Row ) {
-            std::swap(c1, c2);
-        } //if ( c2.Row < c1.Row )
-        return Rectangle{.C1   = c1,
-                         .C2   = c2,
-                         .Area = (std::abs(c1.Row - c2.Row) + 1) * (std::abs(c1.Column - c2.Column) + 1)};
-    };
-    auto ret = symmetricCartesianProduct(list) | std::views::transform(calcArea) | std::ranges::to<std::vector>();
-    std::ranges::sort(ret, std::ranges::greater{}, &Rectangle::Area);
-    return ret;
+std::int64_t area(const Coordinate& c1, const Coordinate& c2) noexcept {
+    return (std::abs(c1.Row - c2.Row) + 1) * (std::abs(c1.Column - c2.Column) + 1);
 }
 
-std::int64_t areaOfLargestRedAndGreenRectangle(std::span<const Rectangle> rectangles, const List& list) {
-    struct Edge {
-        Coordinate From;
-        Coordinate To;
-
-        constexpr auto operator<=>(const Edge& that) const noexcept = default;
-    };
-
-    struct ColumnLess {
-        static bool operator()(const Edge& lhs, const Edge& rhs) noexcept {
-            return std::tie(lhs.From.Column, lhs.From.Row, lhs.To.Column, lhs.To.Row) <
-                   std::tie(rhs.From.Column, rhs.From.Row, rhs.To.Column, rhs.To.Row);
-        }
-    };
-
-    std::flat_set<Edge, ColumnLess> verticalEdges;
-    std::flat_set<Edge>             horizontalEdges;
-
-    for ( const auto& [a, b] : std::views::concat(list, std::views::single(list.front())) | std::views::adjacent<2> ) {
-        const auto [minRow, maxRow]       = std::minmax(a.Row, b.Row);
-        const auto [minColumn, maxColumn] = std::minmax(a.Column, b.Column);
-        const Edge edge{.From = Coordinate{.Row = minRow, .Column = minColumn},
-                        .To   = Coordinate{.Row = maxRow, .Column = maxColumn}};
-
-        if ( minRow == maxRow ) {
-            horizontalEdges.emplace(edge);
-        } //if ( minRow == maxRow )
-        else {
-            verticalEdges.emplace(edge);
-        } //else -> if ( minRow == maxRow )
-    } //for ( const auto& [a, b] : list | std::views::adjacent<2> )
-
-    const auto toFromRow    = [](const Edge& edge) noexcept { return edge.From.Row; };
-    const auto toFromColumn = [](const Edge& edge) noexcept { return edge.From.Column; };
-    const auto toToColumn   = [](const Edge& edge) noexcept { return edge.To.Column; };
-    const auto toToRow      = [](const Edge& edge) noexcept { return edge.To.Row; };
-
-    const auto hits         = [](const Coordinate& c) noexcept {
-        return [c](const Edge& edge) noexcept { return edge.From == c || edge.To == c; };
+/**
+ * @brief The area of the largest rectangle spanned by two corners of list, whose indices accept takes.
+ *
+ * No rectangle of a corner is larger than the one to the farthest corner of the bounding box. The corners are visited
+ * by that bound, so the search stops once no bound exceeds the best area, and accept is only asked for rectangles,
+ * which would be an improvement. Besides the corners nothing is stored.
+ */
+template<typename Accept>
+std::int64_t largestRectangle(const List& list, const Accept& accept) {
+    struct Corner {
+        std::int64_t Bound;
+        std::size_t  Index;
+        Coordinate   Position;
     };
 
-    auto checkLeftToRight = [&horizontalEdges, &verticalEdges, &toFromRow, &toFromColumn,
-                             &hits](const std::int64_t row, std::int64_t left, const std::int64_t right,
-                                    const bool topAllowed, const std::int64_t rowLimit) {
-        const auto edgesOnThisRow         = std::ranges::equal_range(horizontalEdges, row, {}, toFromRow);
-        const auto lowerBoundCuttingEdges = std::ranges::upper_bound(verticalEdges, left, {}, toFromColumn);
-        const auto upperBoundCuttingEdges =
-            std::ranges::lower_bound(lowerBoundCuttingEdges, verticalEdges.end(), right, {}, toFromColumn);
-
-        auto       horizontalEdge     = std::ranges::lower_bound(edgesOnThisRow, left, {}, toFromColumn);
-        const auto horizontalEnd      = edgesOnThisRow.end();
-        auto       verticalEdge       = lowerBoundCuttingEdges;
-        const auto verticalEnd        = upperBoundCuttingEdges;
-        bool       firstEdge          = true;
-        bool       checkForTopAllowed = false;
-
-        if ( horizontalEdge->From.Row != row ) {
-            //Shouldn't have looked for toFromColumn, but toToColumn, adapt manually, this is O(1).
-            --horizontalEdge;
-            checkForTopAllowed = true;
-            throwIfInvalid(horizontalEdge->From.Row == row);
-        } //if ( horizontalEdge->From.Row != row )
-
-        const auto advanceVertical = [&verticalEdge, &verticalEnd, row](std::int64_t column) noexcept {
-            verticalEdge = std::ranges::find_if(verticalEdge, verticalEnd, [row, column](const Edge& edge) noexcept {
-                return edge.From.Row <= row && row <= edge.To.Row && edge.From.Column >= column;
-            });
-            return;
-        };
-
-        advanceVertical(left);
-
-        while ( left < right ) {
-            if ( verticalEdge != verticalEnd && verticalEdge->From.Column < horizontalEdge->From.Column ) {
-                //Crossing a vertical Edge -> Instant disquallify.
-                return false;
-            } //if ( verticalEdge != verticalEnd && verticalEdge->From.Column < horizontalEdge->From.Column )
-
-            if ( horizontalEdge->From.Column <= right && right <= horizontalEdge->To.Column ) {
-                //The end is on an edge, this is in the loop.
-                return true;
-            } //if ( horizontalEdge->From.Column <= right && right <= horizontalEdge->To.Column )
-
-            if ( firstEdge ) {
-                firstEdge                = false;
-
-                const auto leftVertical  = std::ranges::find_if(verticalEdges, hits(horizontalEdge->From));
-                const auto rightVertical = std::ranges::find_if(verticalEdges, hits(horizontalEdge->To));
-
-                const auto leftGoesUp    = leftVertical->From.Row < horizontalEdge->From.Row;
-                const auto rightGoesUp   = rightVertical->From.Row < horizontalEdge->To.Row;
-
-                if ( checkForTopAllowed ) {
-                    if ( rightGoesUp != topAllowed ) {
-                        const auto otherSide = (rightGoesUp ? rightVertical->From : rightVertical->To).Row;
-                        if ( (!topAllowed && otherSide > rowLimit) || (topAllowed && otherSide < rowLimit) ) {
-                            return false;
-                        } //if ( (!topAllowed && otherSide > rowLimit) || (topAllowed && otherSide < rowLimit) )
-                    } //if ( bottomGoesLeft == topAllowed )
-                } //if ( checkForTopAllowed )
-                else {
-                    if ( leftGoesUp == rightGoesUp ) {
-                        //The Target isn't on the starting Edge and it's not a step, thus we leave the loop.
-                        return false;
-                    } //if ( leftGoesUp == rightGoesUp )
-
-                } //else -> if ( checkForTopAllowed )
-            } //if ( firstEdge )
-
-            const auto leftVertical  = std::ranges::find_if(verticalEdge, verticalEnd, hits(horizontalEdge->From));
-            const auto rightVertical = std::ranges::find_if(leftVertical, verticalEnd, hits(horizontalEdge->To));
-
-            if ( leftVertical != verticalEnd ) {
-                throwIfInvalid(rightVertical != verticalEnd);
-                const auto leftGoesUp  = leftVertical->From.Row < horizontalEdge->From.Row;
-                const auto rightGoesUp = rightVertical->From.Row < horizontalEdge->To.Row;
-
-                if ( leftGoesUp != rightGoesUp ) {
-                    //Hit an edge which is just a step, one side of that is outside the loop.
-                    return false;
-                } //if ( leftGoesUp != rightGoesUp )
-            } //if ( leftVertical != verticalEnd )
-
-            left = horizontalEdge->To.Column + 1;
-            ++horizontalEdge;
-            advanceVertical(left);
-
-            if ( horizontalEdge == horizontalEnd || horizontalEdge->From.Row != row ) {
-                //No edges on this available anymore, only check the vertical ones.
-                return verticalEdge == verticalEnd;
-            } //if ( horizontalEdge == horizontalEnd || horizontalEdge->From.Row != row )
-        } //while ( left < right )
-
-        return true;
-    };
-
-    auto checkRightToLeft = [&horizontalEdges, &verticalEdges, &toFromRow, &toFromColumn, &toToColumn,
-                             &hits](const std::int64_t row, std::int64_t right, const std::int64_t left,
-                                    const bool bottomAllowed, const std::int64_t rowLimit) {
-        const auto edgesOnThisRow = std::ranges::equal_range(horizontalEdges, row, {}, toFromRow) | std::views::reverse;
-        const auto lowerBoundCuttingEdges = std::ranges::upper_bound(verticalEdges, left, {}, toFromColumn);
-        const auto upperBoundCuttingEdges =
-            std::ranges::lower_bound(lowerBoundCuttingEdges, verticalEdges.end(), right, {}, toFromColumn);
-
-        auto       horizontalEdge        = std::ranges::lower_bound(edgesOnThisRow, right, {}, toToColumn);
-        const auto horizontalEnd         = edgesOnThisRow.end();
-        auto       verticalEdge          = std::reverse_iterator{upperBoundCuttingEdges};
-        const auto verticalEnd           = std::reverse_iterator{lowerBoundCuttingEdges};
-        bool       firstEdge             = true;
-        bool       checkForBottomAllowed = false;
-
-        if ( horizontalEdge->From.Row != row ) {
-            //Shouldn't have looked for toToColumn, but toFromColumn, adapt manually, this is O(1).
-            --horizontalEdge;
-            checkForBottomAllowed = true;
-            throwIfInvalid(horizontalEdge->From.Row == row);
-        } //if ( horizontalEdge->From.Row != row )
-
-        const auto advanceVertical = [&verticalEdge, &verticalEnd, row](std::int64_t column) noexcept {
-            verticalEdge = std::ranges::find_if(verticalEdge, verticalEnd, [row, column](const Edge& edge) noexcept {
-                return edge.From.Row <= row && row <= edge.To.Row && edge.From.Column <= column;
-            });
-            return;
-        };
-
-        advanceVertical(right);
-
-        while ( right > left ) {
-            if ( verticalEdge != verticalEnd && verticalEdge->From.Column > horizontalEdge->From.Column ) {
-                //Crossing a vertical Edge -> Instant disquallify.
-                return false;
-            } //if ( verticalEdge != verticalEnd && verticalEdge->From.Column > horizontalEdge->From.Column )
-
-            if ( horizontalEdge->From.Column <= left && left <= horizontalEdge->To.Column ) {
-                //The end is on an edge, this is in the loop.
-                return true;
-            } //if ( horizontalEdge->From.Column <= left && left <= horizontalEdge->To.Column )
-
-            if ( firstEdge ) {
-                firstEdge                = false;
-
-                const auto leftVertical  = std::ranges::find_if(verticalEdges, hits(horizontalEdge->From));
-                const auto rightVertical = std::ranges::find_if(verticalEdges, hits(horizontalEdge->To));
-
-                const auto leftGoesUp    = leftVertical->From.Row < horizontalEdge->From.Row;
-                const auto rightGoesUp   = rightVertical->From.Row < horizontalEdge->To.Row;
-
-                if ( checkForBottomAllowed ) {
-                    if ( rightGoesUp == bottomAllowed ) {
-                        const auto otherSide = (rightGoesUp ? rightVertical->From : rightVertical->To).Row;
-                        if ( (!bottomAllowed && otherSide > rowLimit) || (bottomAllowed && otherSide < rowLimit) ) {
-                            return false;
-                        } //if ( (!bottomAllowed && otherSide > rowLimit) || (bottomAllowed && otherSide < rowLimit) )
-                    } //if ( rightGoesUp == bottomAllowed )
-                } //if ( checkForBottomAllowed )
-                else {
-                    if ( leftGoesUp == rightGoesUp ) {
-                        //The Target isn't on the starting Edge and it's not a step, thus we leave the loop.
-                        return false;
-                    } //if ( leftGoesUp == rightGoesUp )
-                } //else -> if ( checkForBottomAllowed )
-            } //if ( firstEdge )
-
-            const auto rightVertical = std::ranges::find_if(verticalEdge, verticalEnd, hits(horizontalEdge->To));
-            const auto leftVertical  = std::ranges::find_if(rightVertical, verticalEnd, hits(horizontalEdge->From));
-
-            if ( leftVertical != verticalEnd ) {
-                throwIfInvalid(rightVertical != verticalEnd);
-                const auto leftGoesUp  = leftVertical->From.Row < horizontalEdge->From.Row;
-                const auto rightGoesUp = rightVertical->From.Row < horizontalEdge->To.Row;
-
-                if ( leftGoesUp != rightGoesUp ) {
-                    //Hit an edge which is just a step, one side of that is outside the loop.
-                    return false;
-                } //if ( leftGoesUp != rightGoesUp )
-            } //if ( leftVertical != verticalEnd )
-
-            right = horizontalEdge->From.Column - 1;
-            ++horizontalEdge;
-            advanceVertical(right);
-
-            if ( horizontalEdge == horizontalEnd || horizontalEdge->From.Row != row ) {
-                //No edges on this available anymore, only check the vertical ones.
-                return verticalEdge == verticalEnd;
-            } //if ( horizontalEdge == horizontalEnd || horizontalEdge->From.Row != row )
-        } //while ( right > left )
-
-        return true;
+    const auto [minRow, maxRow]       = std::ranges::minmax(list | std::views::transform(&Coordinate::Row));
+    const auto [minColumn, maxColumn] = std::ranges::minmax(list | std::views::transform(&Coordinate::Column));
+    const auto toCorner               = [&list, minRow, maxRow, minColumn, maxColumn](std::size_t index) noexcept {
+        const auto& position = list[index];
+        const auto  rows     = std::max(position.Row - minRow, maxRow - position.Row) + 1;
+        const auto  columns  = std::max(position.Column - minColumn, maxColumn - position.Column) + 1;
+        return Corner{.Bound = rows * columns, .Index = index, .Position = position};
     };
+    auto corners =
+        std::views::iota(0uz, list.size()) | std::views::transform(toCorner) | std::ranges::to<std::vector>();
+    std::ranges::sort(corners, std::ranges::greater{}, &Corner::Bound);
+
+    //Every earlier corner has at least the same bound, so all pairs with the current one are worth checking.
+    std::int64_t best = 0;
+    for ( std::size_t i = 1; i < corners.size() && corners[i].Bound > best; ++i ) {
+        for ( std::size_t j = 0; j < i; ++j ) {
+            const auto candidate = area(corners[i].Position, corners[j].Position);
+            if ( candidate > best && accept(corners[i].Index, corners[j].Index) ) {
+                best = candidate;
+            } //if ( candidate > best && accept(corners[i].Index, corners[j].Index) )
+        } //for ( std::size_t j = 0; j < i; ++j )
+    } //for ( std::size_t i = 1; i < corners.size() && corners[i].Bound > best; ++i )
+    return best;
+}
 
-    auto checkTopToBottom = [&horizontalEdges, &verticalEdges, &toFromRow, &toFromColumn,
-                             &hits](const std::int64_t column, std::int64_t top, const std::int64_t bottom,
-                                    const bool leftAllowed, const std::int64_t columnLimit) {
-        const auto edgesOnThisColumn      = std::ranges::equal_range(verticalEdges, column, {}, toFromColumn);
-        const auto lowerBoundCuttingEdges = std::ranges::upper_bound(horizontalEdges, top, {}, toFromRow);
-        const auto upperBoundCuttingEdges =
-            std::ranges::lower_bound(lowerBoundCuttingEdges, horizontalEdges.end(), bottom, {}, toFromRow);
-
-        auto       verticalEdge        = std::ranges::lower_bound(edgesOnThisColumn, top, {}, toFromRow);
-        const auto verticalEnd         = edgesOnThisColumn.end();
-        auto       horizontalEdge      = lowerBoundCuttingEdges;
-        const auto horizontalEnd       = upperBoundCuttingEdges;
-        bool       firstEdge           = true;
-        bool       checkForLeftAllowed = false;
-
-        if ( verticalEdge == verticalEnd || verticalEdge->From.Column != column ) {
-            //Shouldn't have looked for toFromRow, but toToRow, adapt manually, this is O(1).
-            --verticalEdge;
-            checkForLeftAllowed = true;
-            throwIfInvalid(verticalEdge->From.Column == column);
-        } //if ( verticalEdge == verticalEnd || verticalEdge->From.Column != column )
+std::int64_t areaOfLargestRectangle(const List& list) {
+    return largestRectangle(list, [](std::size_t, std::size_t) noexcept { return true; });
+}
 
-        const auto advanceHorizontal = [&horizontalEdge, &horizontalEnd, column](std::int64_t row) noexcept {
-            horizontalEdge =
-                std::ranges::find_if(horizontalEdge, horizontalEnd, [row, column](const Edge& edge) noexcept {
-                    return edge.From.Column < column && column < edge.To.Column && edge.From.Row >= row;
-                });
+/**
+ * @brief The polygon rasterized on its compressed coordinates, tells in O(1) whether the rectangle spanned by two
+ * vertices lies within it.
+ *
+ * Every distinct row and column of the vertices gets a line in the raster, as does every gap before, between and after
+ * them, which contains at least one tile. The outside is flood filled from the margin, a prefix sum table then counts
+ * the outside cells of a rectangle. The raster position of every vertex is kept by its index, so a query needs no
+ * search at all.
+ */
+class ContainmentIndex {
+    public:
+    explicit ContainmentIndex(const List& polygon) {
+        const Axis rows{polygon, &Coordinate::Row};
+        const Axis columns{polygon, &Coordinate::Column};
+        Corners = polygon | std::views::transform([&rows, &columns](const Coordinate& vertex) noexcept {
+                      return Coordinate{rows.line(vertex.Row), columns.line(vertex.Column)};
+                  }) |
+                  std::ranges::to<std::vector>();
+
+        Grid<char> raster{rows.lines(), columns.lines(), Unknown, Border};
+        for ( const auto& [a, b] : std::views::concat(Corners, std::views::single(Corners.front())) |
+                                       std::views::adjacent<2> ) {
+            throwIfInvalid(a.Row == b.Row || a.Column == b.Column, "Diagonal edge");
+            const auto [fromRow, toRow]       = std::minmax(a.Row, b.Row);
+            const auto [fromColumn, toColumn] = std::minmax(a.Column, b.Column);
+            for ( auto row = fromRow; row <= toRow; ++row ) {
+                for ( auto column = fromColumn; column <= toColumn; ++column ) {
+                    raster[Coordinate{row, column}] = Boundary;
+                } //for ( auto column = fromColumn; column <= toColumn; ++column )
+            } //for ( auto row = fromRow; row <= toRow; ++row )
+        } //for ( const auto& [a, b] : ... )
+
+        //The margin is outside, the border around it stops the fill.
+        std::vector<Grid<char>::Index> stack{raster.index({0, 0})};
+        raster[stack.back()] = Outside;
+        while ( !stack.empty() ) {
+            const auto index = stack.back();
+            stack.pop_back();
+            for ( const auto offset : raster.neighborOffsets() ) {
+                if ( raster[index + offset] == Unknown ) {
+                    raster[index + offset] = Outside;
+                    stack.push_back(index + offset);
+                } //if ( raster[index + offset] == Unknown )
+            } //for ( const auto offset : raster.neighborOffsets() )
+        } //while ( !stack.empty() )
+
+        Stride = raster.columns() + 1;
+        OutsideBefore.resize(static_cast<std::size_t>((raster.rows() + 1) * Stride));
+        for ( std::int64_t row = 0; row < raster.rows(); ++row ) {
+            for ( std::int64_t column = 0; column < raster.columns(); ++column ) {
+                outsideBefore(row + 1, column + 1) = outsideBefore(row, column + 1) + outsideBefore(row + 1, column) -
+                                                     outsideBefore(row, column) +
+                                                     (raster[Coordinate{row, column}] == Outside ? 1 : 0);
+            } //for ( std::int64_t column = 0; column < raster.columns(); ++column )
+        } //for ( std::int64_t row = 0; row < raster.rows(); ++row )
+        return;
+    }
+
+    bool contains(std::size_t vertex1, std::size_t vertex2) const noexcept {
+        const auto corner1                = Corners[vertex1];
+        const auto corner2                = Corners[vertex2];
+        const auto [fromRow, toRow]       = std::minmax(corner1.Row, corner2.Row);
+        const auto [fromColumn, toColumn] = std::minmax(corner1.Column, corner2.Column);
+        //No outside cell means the counts before both column bounds differ equally between the row bounds.
+        return outsideBefore(toRow + 1, toColumn + 1) - outsideBefore(fromRow, toColumn + 1) ==
+               outsideBefore(toRow + 1, fromColumn) - outsideBefore(fromRow, fromColumn);
+    }
+
+    private:
+    static constexpr char Unknown  = ' ';
+    static constexpr char Boundary = '#';
+    static constexpr char Outside  = '.';
+    static constexpr char Border   = '\0';
+
+    /**
+     * @brief Maps the distinct values of one axis to their raster lines.
+     */
+    class Axis {
+        public:
+        Axis(const List& polygon, std::int64_t Coordinate::* member) :
+                Values{polygon | std::views::transform(member) | std::ranges::to<std::vector>()} {
+            std::ranges::sort(Values);
+            const auto [first, last] = std::ranges::unique(Values);
+            Values.erase(first, last);
+
+            //Line 0 is the margin, adjacent values have no tile between them and thus need no gap line.
+            Lines.reserve(Values.size());
+            std::int64_t line = -1;
+            for ( std::size_t i = 0; i < Values.size(); ++i ) {
+                line += i > 0 && Values[i] - Values[i - 1] == 1 ? 1 : 2;
+                Lines.push_back(line);
+            } //for ( std::size_t i = 0; i < Values.size(); ++i )
             return;
-        };
-
-        advanceHorizontal(top);
-
-        while ( top < bottom ) {
-            if ( horizontalEdge != horizontalEnd && horizontalEdge->From.Row < verticalEdge->From.Row ) {
-                //Crossing a vertical Edge -> Instant disquallify.
-                return false;
-            } //if ( horizontalEdge != horizontalEnd && horizontalEdge->From.Row < verticalEdge->From.Row )
-
-            if ( verticalEdge->From.Row <= bottom && bottom <= verticalEdge->To.Row ) {
-                //The end is on an edge, this is in the loop.
-                return true;
-            } //if ( verticalEdge->From.Row <= bottom && bottom <= verticalEdge->To.Row )
-
-            if ( firstEdge ) {
-                firstEdge                   = false;
-
-                const auto topHorizontal    = std::ranges::find_if(horizontalEdges, hits(verticalEdge->From));
-                const auto bottomHorizontal = std::ranges::find_if(horizontalEdges, hits(verticalEdge->To));
-
-                const auto topGoesLeft      = topHorizontal->From.Column < verticalEdge->From.Column;
-                const auto bottomGoesLeft   = bottomHorizontal->From.Column < verticalEdge->To.Column;
-
-                if ( checkForLeftAllowed ) {
-                    if ( bottomGoesLeft != leftAllowed ) {
-                        const auto otherSide = (bottomGoesLeft ? bottomHorizontal->From : bottomHorizontal->To).Column;
-                        if ( (!leftAllowed && otherSide > columnLimit) || (leftAllowed && otherSide < columnLimit) ) {
-                            return false;
-                        } //if ( (!leftAllowed && otherSide > columnLimit) || (leftAllowed && otherSide < columnLimit) )
-                    } //if ( bottomGoesLeft != leftAllowed )
-                } //if ( checkForLeftAllowed )
-                else {
-                    if ( topGoesLeft == bottomGoesLeft ) {
-                        //The Target isn't on the starting Edge and it's not a step, thus we leave the loop.
-                        return false;
-                    } //if ( topGoesLeft == bottomGoesLeft )
-                } //else -> if ( checkForLeftAllowed )
-            } //if ( firstEdge )
-
-            const auto topHorizontal    = std::ranges::find_if(horizontalEdge, horizontalEnd, hits(verticalEdge->From));
-            const auto bottomHorizontal = std::ranges::find_if(topHorizontal, horizontalEnd, hits(verticalEdge->To));
-
-            if ( topHorizontal != bottomHorizontal ) {
-                throwIfInvalid(topHorizontal != verticalEnd);
-                const auto topGoesLeft    = topHorizontal->From.Column < horizontalEdge->From.Column;
-                const auto bottomGoesLeft = bottomHorizontal->From.Column < horizontalEdge->To.Column;
-
-                if ( topGoesLeft != bottomGoesLeft ) {
-                    //Hit an edge which is just a step, one side of that is outside the loop.
-                    return false;
-                } //if ( topGoesLeft != bottomGoesLeft )
-            } //if ( topHorizontal != bottomHorizontal )
+        }
 
-            top = verticalEdge->To.Row + 1;
-            ++verticalEdge;
-            advanceHorizontal(top);
+        /**
+         * @brief The number of raster lines, including the margins.
+         */
+        std::int64_t lines(void) const noexcept {
+            return Lines.back() + 2;
+        }
 
-            if ( verticalEdge == verticalEnd || verticalEdge->From.Column != column ) {
-                //No edges on this available anymore, only check the vertical ones.
-                return horizontalEdge == horizontalEnd;
-            } //if ( verticalEdge == verticalEnd || verticalEdge->From.Column != column )
-        } //while ( top < bottom )
+        std::int64_t line(std::int64_t value) const noexcept {
+            return Lines[static_cast<std::size_t>(
+                std::ranges::distance(Values.begin(), std::ranges::lower_bound(Values, value)))];
+        }
 
-        return true;
+        private:
+        std::vector<std::int64_t> Values;
+        std::vector<std::int64_t> Lines;
     };
 
-    auto checkBottomToTop = [&horizontalEdges, &verticalEdges, &toFromRow, &toFromColumn, &toToRow,
-                             &hits](const std::int64_t column, std::int64_t bottom, const std::int64_t top,
-                                    const bool rightAllowed, const std::int64_t columnLimit) {
-        const auto edgesOnThisRow =
-            std::ranges::equal_range(verticalEdges, column, {}, toFromColumn) | std::views::reverse;
-        const auto lowerBoundCuttingEdges = std::ranges::upper_bound(horizontalEdges, top, {}, toFromRow);
-        const auto upperBoundCuttingEdges =
-            std::ranges::lower_bound(lowerBoundCuttingEdges, horizontalEdges.end(), bottom, {}, toFromRow);
-
-        auto       verticalEdge         = std::ranges::lower_bound(edgesOnThisRow, top, {}, toToRow);
-        const auto verticalEnd          = edgesOnThisRow.end();
-        auto       horizontalEdge       = std::reverse_iterator{upperBoundCuttingEdges};
-        const auto horizontalEnd        = std::reverse_iterator{lowerBoundCuttingEdges};
-        bool       firstEdge            = true;
-        bool       checkForRightAllowed = false;
-
-        if ( verticalEdge->From.Column != column ) {
-            //Shouldn't have looked for toToRow, but toFromRow, adapt manually, this is O(1).
-            --verticalEdge;
-            checkForRightAllowed = true;
-            throwIfInvalid(verticalEdge->From.Column == column);
-        } //if ( verticalEdge->From.Column != column )
-
-        const auto advanceHorizontal = [&horizontalEdge, &horizontalEnd, column](std::int64_t row) noexcept {
-            horizontalEdge =
-                std::ranges::find_if(horizontalEdge, horizontalEnd, [row, column](const Edge& edge) noexcept {
-                    return edge.From.Column <= column && column <= edge.To.Column && edge.From.Row <= row;
-                });
-            return;
-        };
-
-        advanceHorizontal(bottom);
-
-        while ( bottom > top ) {
-            if ( horizontalEdge != horizontalEnd && horizontalEdge->From.Row > verticalEdge->To.Row ) {
-                //Crossing a vertical Edge -> Instant disquallify.
-                return false;
-            } //if ( horizontalEdge != horizontalEnd && horizontalEdge->From.Row > verticalEdge->To.Row )
-
-            if ( verticalEdge->From.Row <= top && top <= verticalEdge->To.Row ) {
-                //The end is on an edge, this is in the loop.
-                return true;
-            } //if ( verticalEdge->From.Row <= top && top <= verticalEdge->To.Row )
-
-            if ( firstEdge ) {
-                firstEdge                   = false;
-
-                const auto topHorizontal    = std::ranges::find_if(horizontalEdges, hits(verticalEdge->From));
-                const auto bottomHorizontal = std::ranges::find_if(horizontalEdges, hits(verticalEdge->To));
+    List                      Corners;
+    std::int64_t              Stride = 0;
+    std::vector<std::int64_t> OutsideBefore;
 
-                const auto topGoesLeft      = topHorizontal->From.Column < verticalEdge->From.Column;
-                const auto bottomGoesLeft   = bottomHorizontal->From.Column < verticalEdge->To.Column;
+    /**
+     * @brief The number of outside cells in the raster rows [0, row) and columns [0, column).
+     */
+    std::int64_t& outsideBefore(std::int64_t row, std::int64_t column) noexcept {
+        return OutsideBefore[static_cast<std::size_t>(row * Stride + column)];
+    }
 
-                if ( checkForRightAllowed ) {
-                    if ( bottomGoesLeft == rightAllowed ) {
-                        const auto otherSide = (bottomGoesLeft ? bottomHorizontal->From : bottomHorizontal->To).Column;
-                        if ( (!rightAllowed && otherSide > columnLimit) || (rightAllowed && otherSide < columnLimit) ) {
-                            return false;
-                        } //if ( (!rightAllowed && otherSide > columnLimit) || (rightAllowed && otherSide < columnLimit)
-                          //)
-                    } //if ( bottomGoesLeft != leftAllowed )
-                } //if ( checkForRightAllowed )
-                else {
-                    if ( topGoesLeft == bottomGoesLeft ) {
-                        //The Target isn't on the starting Edge and it's not a step, thus we leave the loop.
-                        return false;
-                    } //if ( topGoesLeft == bottomGoesLeft )
-                } //else -> if ( checkForRightAllowed )
-            } //if ( firstEdge )
-
-            const auto bottomHorizontal = std::ranges::find_if(horizontalEdge, horizontalEnd, hits(verticalEdge->To));
-            const auto topHorizontal = std::ranges::find_if(bottomHorizontal, horizontalEnd, hits(verticalEdge->From));
-
-            if ( topHorizontal != horizontalEnd ) {
-                throwIfInvalid(bottomHorizontal != horizontalEnd);
-                const auto topGoesLeft    = topHorizontal->From.Column < verticalEdge->From.Column;
-                const auto bottomGoesLeft = bottomHorizontal->From.Column < verticalEdge->To.Column;
-
-                if ( topGoesLeft != bottomGoesLeft ) {
-                    //Hit an edge which is just a step, one side of that is outside the loop.
-                    return false;
-                } //if ( topGoesLeft != bottomGoesLeft )
-            } //if ( topHorizontal != horizontalEnd )
-
-            bottom = verticalEdge->From.Row - 1;
-            ++verticalEdge;
-            advanceHorizontal(bottom);
-
-            if ( verticalEdge == verticalEnd || verticalEdge->From.Column != column ) {
-                //No edges on this available anymore, only check the vertical ones.
-                return horizontalEdge == horizontalEnd;
-            } //if ( verticalEdge == verticalEnd || verticalEdge->From.Column != column )
-        } //while ( right > left )
-
-        return true;
-    };
-
-    auto isValidRedAndGreen = [&checkLeftToRight, &checkRightToLeft, &checkTopToBottom,
-                               &checkBottomToTop](const Rectangle& rectangle) {
-        if ( rectangle.C1.Column < rectangle.C2.Column ) {
-            return checkLeftToRight(rectangle.C1.Row, rectangle.C1.Column, rectangle.C2.Column, /*topAllowed=*/true,
-                                    /*rowLimit=*/rectangle.C2.Row) &&
-                   checkTopToBottom(rectangle.C1.Column, rectangle.C1.Row, rectangle.C2.Row, /*leftAllowed=*/true,
-                                    /*columnLimit=*/rectangle.C2.Column) &&
-                   checkRightToLeft(rectangle.C2.Row, rectangle.C2.Column, rectangle.C1.Column, /*bottomAllowed=*/true,
-                                    /*rowLimit=*/rectangle.C1.Row) &&
-                   checkBottomToTop(rectangle.C2.Column, rectangle.C2.Row, rectangle.C1.Row, /*rightAllowed=*/true,
-                                    /*columnLimit=*/rectangle.C1.Column);
-        } //if ( rectangle.C1.Column < rectangle.C2.Column )
+    std::int64_t outsideBefore(std::int64_t row, std::int64_t column) const noexcept {
+        return OutsideBefore[static_cast<std::size_t>(row * Stride + column)];
+    }
+};
 
-        return checkRightToLeft(rectangle.C1.Row, rectangle.C1.Column, rectangle.C2.Column, /*bottomAllowed=*/false,
-                                /*rowLimit=*/rectangle.C2.Row) &&
-               checkTopToBottom(rectangle.C1.Column, rectangle.C1.Row, rectangle.C2.Row, /*leftAllowed=*/false,
-                                /*columnLimit=*/rectangle.C2.Column) &&
-               checkLeftToRight(rectangle.C2.Row, rectangle.C2.Column, rectangle.C1.Column, /*topAllowed=*/false,
-                                /*rowLimit=*/rectangle.C1.Row) &&
-               checkBottomToTop(rectangle.C2.Column, rectangle.C2.Row, rectangle.C1.Row, /*rightAllowed=*/false,
-                                /*columnLimit=*/rectangle.C1.Column);
-    };
-    return std::ranges::find_if(rectangles, isValidRedAndGreen)->Area;
+std::int64_t areaOfLargestRedAndGreenRectangle(const List& list) {
+    const ContainmentIndex index{list};
+    return largestRectangle(list, [&index](std::size_t vertex1, std::size_t vertex2) noexcept {
+        return index.contains(vertex1, vertex2);
+    });
 }
 } //namespace
 
 bool challenge9(const std::vector<std::string_view>& input) {
-    const auto list       = parse(input);
-    const auto rectangles = calculateRectangles(list);
-    const auto area1      = rectangles.front().Area;
+    const auto list  = timePhase("parse", parse, input);
+    const auto area1 = timePhase("part 1", areaOfLargestRectangle, list);
     myPrint(" == Result of Part 1: {:d} ==\n", area1);
 
-    const auto area2 = areaOfLargestRedAndGreenRectangle(rectangles, list);
+    const auto area2 = timePhase("part 2", areaOfLargestRedAndGreenRectangle, list);
     myPrint(" == Result of Part 2: {:d} ==\n", area2);
 
     return area1 == 4'769'758'290 && area2 == 1'588'990'708;
@@ -1,9 +1,11 @@
 #ifndef COORDINATE3D_HPP
 #define COORDINATE3D_HPP
 
+#include "helper.hpp"
+
 #include <cmath>
+#include <cstdint>
 #include <functional>
-#include <limits>
 
 template<typename T>
 struct Coordinate3D {
@@ -50,9 +52,8 @@ namespace std {
 template<typename T>
 struct hash<Coordinate3D<T>> {
     size_t operator()(const Coordinate3D<T>& c) const noexcept {
-        constexpr auto bits = std::numeric_limits<T>::digits / 3;
-        constexpr auto mask = ((T{1} << bits) - 1);
-        return std::hash<T>{}((c.X << (2 * bits)) | ((c.Y & mask) << bits) | (c.Z & mask));
+        const auto hash = hashCombine(static_cast<std::uint64_t>(c.X), static_cast<std::uint64_t>(c.Y));
+        return hashCombine(hash, static_cast<std::uint64_t>(c.Z));
     }
 };
 } //namespace std
@@ -0,0 +1,148 @@
+#ifndef GRID_HPP
+#define GRID_HPP
+
+#include "helper.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A dense, row major 2D grid, surrounded by a border of sentinel cells.
+ *
+ * Every interior cell has all its (diagonal) neighbors within the storage, so as long as the border value is
+ * distinguishable from the content, neighbor lookups need no bounds check. Cells can be addressed by a coordinate or
+ * by a linear index, to which the neighbor offsets can be added directly.
+ */
+template<typename T>
+class Grid {
+    public:
+    using Index      = std::ptrdiff_t;
+    using Coordinate = ::Coordinate<std::int64_t>;
+
+    Grid(std::int64_t rows, std::int64_t columns, const T& value, const T& border, std::int64_t padding = 1) :
+            Rows{rows}, Columns{columns}, Padding{padding}, Stride{columns + 2 * padding},
+            Cells(static_cast<std::size_t>((rows + 2 * padding) * Stride), border) {
+        throwIfInvalid(rows >= 0 && columns >= 0 && padding >= 1);
+        for ( std::int64_t row = 0; row < Rows; ++row ) {
+            std::ranges::fill(this->row(row), value);
+        } //for ( std::int64_t row = 0; row < Rows; ++row )
+        return;
+    }
+
+    /**
+     * @brief Copies the lines into a grid, all lines have to be of the same length.
+     */
+    static Grid fromLines(std::span<const std::string_view> lines, const T& border, std::int64_t padding = 1)
+        requires std::constructible_from<T, char>
+    {
+        throwIfInvalid(!lines.empty() && !lines.front().empty());
+        const auto columns = static_cast<std::int64_t>(lines.front().size());
+        Grid       ret{static_cast<std::int64_t>(lines.size()), columns, border, border, padding};
+        for ( std::int64_t row = 0; const auto line : lines ) {
+            throwIfInvalid(line.size() == lines.front().size(), "Ragged grid");
+            std::ranges::copy(line, ret.row(row++).begin());
+        } //for ( std::int64_t row = 0; const auto line : lines )
+        return ret;
+    }
+
+    std::int64_t rows(void) const noexcept {
+        return Rows;
+    }
+
+    std::int64_t columns(void) const noexcept {
+        return Columns;
+    }
+
+    std::int64_t padding(void) const noexcept {
+        return Padding;
+    }
+
+    CoordinateBounds<std::int64_t> bounds(void) const noexcept {
+        return {Rows, Columns};
+    }
+
+    bool contains(Coordinate coordinate) const noexcept {
+        return coordinate.isValid(bounds());
+    }
+
+    Index index(Coordinate coordinate) const noexcept {
+        return (coordinate.Row + Padding) * Stride + coordinate.Column + Padding;
+    }
+
+    Coordinate coordinate(Index index) const noexcept {
+        return {index / Stride - Padding, index % Stride - Padding};
+    }
+
+    T& operator[](Index index) noexcept {
+        return Cells[static_cast<std::size_t>(index)];
+    }
+
+    const T& operator[](Index index) const noexcept {
+        return Cells[static_cast<std::size_t>(index)];
+    }
+
+    T& operator[](Coordinate coordinate) noexcept {
+        return (*this)[index(coordinate)];
+    }
+
+    const T& operator[](Coordinate coordinate) const noexcept {
+        return (*this)[index(coordinate)];
+    }
+
+    std::span<T> row(std::int64_t row) noexcept {
+        return std::span{Cells}.subspan(static_cast<std::size_t>(index({row, 0})), static_cast<std::size_t>(Columns));
+    }
+
+    std::span<const T> row(std::int64_t row) const noexcept {
+        return std::span{Cells}.subspan(static_cast<std::size_t>(index({row, 0})), static_cast<std::size_t>(Columns));
+    }
+
+    Index offset(Direction direction) const noexcept {
+        switch ( direction ) {
+            using enum Direction;
+            case Up    : return -Stride;
+            case Down  : return Stride;
+            case Left  : return -1;
+            case Right : return 1;
+        } //switch ( direction )
+        std::unreachable();
+    }
+
+    std::array<Index, 4> neighborOffsets(void) const noexcept {
+        return {-Stride, 1, Stride, -1};
+    }
+
+    std::array<Index, 8> neighborOffsetsWithDiagonal(void) const noexcept {
+        return {-Stride, 1, Stride, -1, -Stride - 1, -Stride + 1, Stride - 1, Stride + 1};
+    }
+
+    /**
+     * @brief The linear indices of all interior cells, row by row.
+     */
+    auto indices(void) const noexcept {
+        return std::views::iota(std::int64_t{0}, Rows) | std::views::transform([this](std::int64_t row) noexcept {
+                   const auto first = index({row, 0});
+                   return std::views::iota(first, first + Columns);
+               }) |
+               std::views::join;
+    }
+
+    auto positions(void) const noexcept {
+        return indices() | std::views::transform([this](Index index) noexcept { return coordinate(index); });
+    }
+
+    private:
+    std::int64_t   Rows;
+    std::int64_t   Columns;
+    std::int64_t   Padding;
+    std::int64_t   Stride;
+    std::vector<T> Cells;
+};
+
+#endif //GRID_HPP
@@ -2,8 +2,14 @@
 
 #include "print.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
+namespace {
+thread_local PhaseLog*   CurrentPhaseLog = nullptr;
+thread_local std::size_t PhaseDepth      = 0;
+} //namespace
+
 void throwIfInvalid(bool valid, const char* msg) {
     if ( !valid ) {
         myFlush();
@@ -16,3 +22,43 @@ void fail(void) {
     throwIfInvalid(false, "Fail");
     std::unreachable();
 }
+
+PhaseRecording::PhaseRecording(PhaseLog& log) noexcept : Previous{std::exchange(CurrentPhaseLog, &log)} {
+    return;
+}
+
+PhaseRecording::~PhaseRecording(void) {
+    CurrentPhaseLog = Previous;
+    return;
+}
+
+ScopedPhase::ScopedPhase(std::string_view name) : Log{CurrentPhaseLog}, Index{0} {
+    if ( Log ) {
+        Index = Log->size();
+        Log->emplace_back(name, std::chrono::steady_clock::now(), std::chrono::nanoseconds{}, PhaseDepth++);
+    } //if ( Log )
+    return;
+}
+
+ScopedPhase::~ScopedPhase(void) {
+    if ( Log ) {
+        auto& timing    = (*Log)[Index];
+        timing.Duration = std::chrono::steady_clock::now() - timing.Start;
+        --PhaseDepth;
+    } //if ( Log )
+    return;
+}
+
+std::vector<std::pair<std::string_view, std::chrono::nanoseconds>> aggregatePhases(const PhaseLog& log) {
+    std::vector<std::pair<std::string_view, std::chrono::nanoseconds>> ret;
+    for ( const auto& timing : log ) {
+        auto iter = std::ranges::find(ret, timing.Name, [](const auto& entry) noexcept { return entry.first; });
+        if ( iter == ret.end() ) {
+            ret.emplace_back(timing.Name, timing.Duration);
+        } //if ( iter == ret.end() )
+        else {
+            iter->second += timing.Duration;
+        } //else -> if ( iter == ret.end() )
+    } //for ( const auto& timing : log )
+    return ret;
+}
@@ -1,17 +1,24 @@
 #ifndef HELPER_HPP
 #define HELPER_HPP
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <charconv>
 #include <chrono>
 #include <coroutine>
 #include <cstdint>
+#include <cstring>
 #include <format>
+#include <functional>
 #include <generator>
+#include <numeric>
 #include <optional>
 #include <print> // IWYU pragma: export
 #include <ranges>
+#include <span>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -50,6 +57,22 @@ inline Direction turnAround(Direction dir) noexcept {
     std::unreachable();
 }
 
+/**
+ * @brief The SplitMix64 finalizer, every input bit affects every output bit.
+ */
+constexpr std::uint64_t mixHash(std::uint64_t value) noexcept {
+    value ^= value >> 30;
+    value *= 0xBF58'476D'1CE4'E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D0'49BB'1331'11EBULL;
+    value ^= value >> 31;
+    return value;
+}
+
+constexpr std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t value) noexcept {
+    return mixHash(std::rotl(seed, 32) ^ value);
+}
+
 template<std::integral T>
 struct CoordinateOffset {
     T Row;
@@ -58,6 +81,10 @@ struct CoordinateOffset {
     constexpr bool operator==(const CoordinateOffset&) const noexcept  = default;
     constexpr auto operator<=>(const CoordinateOffset&) const noexcept = default;
 
+    CoordinateOffset operator+(CoordinateOffset that) const noexcept {
+        return {Row + that.Row, Column + that.Column};
+    }
+
     CoordinateOffset operator*(T factor) const noexcept {
         auto ret{*this};
         ret *= factor;
@@ -75,16 +102,14 @@ struct CoordinateOffset {
     }
 };
 
-struct MapView;
+template<std::integral T>
+struct CoordinateBounds;
 
 template<std::integral T>
 struct Coordinate {
     T Row;
     T Column;
 
-    static inline T MaxRow{};
-    static inline T MaxColumn{};
-
     constexpr bool operator==(const Coordinate&) const noexcept  = default;
     constexpr auto operator<=>(const Coordinate&) const noexcept = default;
 
@@ -104,8 +129,8 @@ struct Coordinate {
         return {Row + 1, Column};
     }
 
-    bool isValid(void) const noexcept {
-        return Row >= 0 && Row < MaxRow && Column >= 0 && Column < MaxColumn;
+    bool isValid(const CoordinateBounds<T>& bounds) const noexcept {
+        return Row >= 0 && Row < bounds.Rows && Column >= 0 && Column < bounds.Columns;
     }
 
     Coordinate& move(Direction where) noexcept {
@@ -134,6 +159,12 @@ struct Coordinate {
         return ret;
     }
 
+    Coordinate operator-(CoordinateOffset<T> offset) const noexcept {
+        auto ret{*this};
+        ret -= offset;
+        return ret;
+    }
+
     Coordinate& operator+=(CoordinateOffset<T> offset) noexcept {
         Row    += offset.Row;
         Column += offset.Column;
@@ -151,8 +182,8 @@ struct Coordinate {
                           moved(Direction::Left)};
     }
 
-    auto validNeighbors(void) const noexcept {
-        return neighbors() | std::views::filter([](Coordinate c) noexcept { return c.isValid(); });
+    auto validNeighbors(const CoordinateBounds<T>& bounds) const noexcept {
+        return neighbors() | std::views::filter([bounds](Coordinate c) noexcept { return c.isValid(bounds); });
     }
 
     auto neighborsWithDiagnonal(void) const noexcept {
@@ -166,16 +197,28 @@ struct Coordinate {
                           moved(Direction::Down).move(Direction::Right)};
     }
 
-    auto validNeighborsWithDiagnonal(void) const noexcept {
-        return neighborsWithDiagnonal() | std::views::filter([](Coordinate c) noexcept { return c.isValid(); });
+    auto validNeighborsWithDiagnonal(const CoordinateBounds<T>& bounds) const noexcept {
+        return neighborsWithDiagnonal() |
+               std::views::filter([bounds](Coordinate c) noexcept { return c.isValid(bounds); });
     }
+};
 
-    static void setMaxFromMap(MapView map);
+/**
+ * @brief The extent of one map, coordinates are valid in [0, Rows) x [0, Columns).
+ */
+template<std::integral T>
+struct CoordinateBounds {
+    T Rows;
+    T Columns;
 
-    static auto allPositions(void) noexcept {
-        return std::views::cartesian_product(std::views::iota(T{0}, MaxRow), std::views::iota(T{0}, MaxColumn)) |
+    bool contains(Coordinate<T> coordinate) const noexcept {
+        return coordinate.isValid(*this);
+    }
+
+    auto allPositions(void) const noexcept {
+        return std::views::cartesian_product(std::views::iota(T{0}, Rows), std::views::iota(T{0}, Columns)) |
                std::views::transform([](auto rowAndColumn) noexcept {
-                   return Coordinate{std::get<0>(rowAndColumn), std::get<1>(rowAndColumn)};
+                   return Coordinate<T>{std::get<0>(rowAndColumn), std::get<1>(rowAndColumn)};
                });
     }
 };
@@ -184,8 +227,7 @@ namespace std {
 template<typename T>
 struct hash<Coordinate<T>> {
     size_t operator()(const Coordinate<T>& c) const noexcept {
-        std::hash<T> h;
-        return h(c.Row << 8) ^ h(c.Column);
+        return hashCombine(static_cast<std::uint64_t>(c.Row), static_cast<std::uint64_t>(c.Column));
     }
 };
 
@@ -207,23 +249,6 @@ struct formatter<Coordinate<T>, char> {
 };
 } //namespace std
 
-struct MapView {
-    std::span<const std::string_view> Base;
-
-    MapView(const std::vector<std::string_view>& base) noexcept : Base{base} {
-        return;
-    }
-
-    MapView(std::span<const std::string_view> base) noexcept : Base{base} {
-        return;
-    }
-
-    template<std::integral T>
-    auto operator[](const Coordinate<T>& coordinate) const noexcept {
-        return Base[static_cast<std::size_t>(coordinate.Row)][static_cast<std::size_t>(coordinate.Column)];
-    }
-};
-
 template<bool SkipEmpty = true>
 constexpr auto splitString(const std::string_view data, const char delimiter) noexcept {
     auto split = data | std::views::split(delimiter) | std::views::transform([](const auto& subRange) noexcept {
@@ -240,12 +265,167 @@ constexpr auto splitString(const std::string_view data, const char delimiter) no
 void throwIfInvalid(bool valid, const char* msg = "Invalid Data");
 [[noreturn]] void fail(void);
 
+enum class ParseMode : std::uint8_t {
+    Validated, ///< Throws on malformed input and overflow.
+    Unchecked, ///< Assumes well formed input, which fits into std::int64_t.
+};
+
+struct ParsedInt {
+    std::int64_t Value;
+    std::size_t  Length;
+};
+
+namespace Swar {
+constexpr std::uint64_t broadcast(std::uint8_t byte) noexcept {
+    return 0x01'01'01'01'01'01'01'01ULL * byte;
+}
+
+/**
+ * @brief Loads up to 8 bytes, missing bytes are 0, which is not a digit.
+ */
+inline std::uint64_t load(const char* data, std::size_t available) noexcept {
+    static_assert(std::endian::native == std::endian::little);
+    std::uint64_t ret = 0;
+    if ( available > 0 ) {
+        std::memcpy(&ret, data, std::min<std::size_t>(available, 8));
+    } //if ( available > 0 )
+    return ret;
+}
+
+/**
+ * @brief The number of leading (in memory order) digit characters in chunk.
+ */
+inline std::size_t leadingDigits(std::uint64_t chunk) noexcept {
+    constexpr auto highNibble = broadcast(0xF0);
+    constexpr auto zero       = broadcast(0x30);
+    //A byte is a digit, iff its high nibble is 3, and stays 3 when adding 6. The carry of non digits only affects the
+    //following bytes, which do not matter.
+    const auto     nonDigit   = ((chunk & highNibble) ^ zero) | (((chunk + broadcast(0x06)) & highNibble) ^ zero);
+    const auto     marker     = (nonDigit | (nonDigit << 1) | (nonDigit << 2) | (nonDigit << 3)) & broadcast(0x80);
+    return static_cast<std::size_t>(std::countr_zero(marker)) / 8;
+}
+
+/**
+ * @brief Combines the first count digits of chunk to a number, count has to be in [1, 8].
+ */
+inline std::uint64_t combine(std::uint64_t chunk, std::size_t count) noexcept {
+    //Move the digits to the top, the zero bytes below are leading zeros.
+    auto value = (chunk & broadcast(0x0F)) << (8 * (8 - count));
+    value      = (value * 10) + (value >> 8);
+    value      = (((value & 0x0000'00FF'0000'00FFULL) * 0x000F'4240'0000'0064ULL) +
+             (((value >> 16) & 0x0000'00FF'0000'00FFULL) * 0x0000'2710'0000'0001ULL)) >>
+            32;
+    return value;
+}
+
+constexpr std::array<std::uint64_t, 9> PowersOf10{1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000,
+                                                  100'000'000};
+} //namespace Swar
+
+/**
+ * @brief Parses the leading (optionally negative) number of input, 8 digits at a time.
+ * @tparam MaxDigits The maximum number of digits expected, smaller values unroll to fewer chunks.
+ * @return The value and the number of consumed characters, a length of 0 means there was no number.
+ */
+template<ParseMode Mode = ParseMode::Validated, std::size_t MaxDigits = 19>
+ParsedInt parseIntPrefix(std::string_view input) {
+    static_assert(MaxDigits > 0 && MaxDigits <= 19);
+    const bool     negative = !input.empty() && input.front() == '-';
+    const auto     begin    = static_cast<std::size_t>(negative);
+    auto           pos      = begin;
+    std::uint64_t  value    = 0;
+    constexpr auto chunks   = (MaxDigits + 7) / 8;
+
+    for ( std::size_t chunk = 0; chunk < chunks; ++chunk ) {
+        const auto data  = Swar::load(input.data() + pos, input.size() - pos);
+        const auto count = Swar::leadingDigits(data);
+        if ( count == 0 ) {
+            break;
+        } //if ( count == 0 )
+
+        value  = value * Swar::PowersOf10[count] + Swar::combine(data, count);
+        pos   += count;
+        if ( count < 8 ) {
+            break;
+        } //if ( count < 8 )
+    } //for ( std::size_t chunk = 0; chunk < chunks; ++chunk )
+
+    if constexpr ( Mode == ParseMode::Validated ) {
+        if ( pos == begin ) {
+            return {0, 0};
+        } //if ( pos == begin )
+
+        const auto moreDigits = pos < input.size() && input[pos] >= '0' && input[pos] <= '9';
+        if ( pos - begin >= 19 || moreDigits ) {
+            //Only such long numbers may overflow (or have leading zeros), let the standard library decide.
+            throwIfInvalid(MaxDigits == 19, "Number too long");
+            std::int64_t ret    = 0;
+            const auto   result = std::from_chars(input.data(), input.data() + input.size(), ret);
+            throwIfInvalid(result.ec == std::errc{}, "Number too large");
+            return {ret, static_cast<std::size_t>(result.ptr - input.data())};
+        } //if ( pos - begin >= 19 || moreDigits )
+    } //if constexpr ( Mode == ParseMode::Validated )
+
+    const auto signedValue = static_cast<std::int64_t>(value);
+    return {negative ? -signedValue : signedValue, pos == begin ? 0 : pos};
+}
+
+template<ParseMode Mode = ParseMode::Validated, std::size_t MaxDigits = 19>
+std::int64_t parseInt(std::string_view input) {
+    const auto [value, length] = parseIntPrefix<Mode, MaxDigits>(input);
+    if constexpr ( Mode == ParseMode::Validated ) {
+        throwIfInvalid(length != 0 && length == input.size(), "Not a number");
+    } //if constexpr ( Mode == ParseMode::Validated )
+    return value;
+}
+
+/**
+ * @brief Parses all numbers in line, which are separated by delimiter, into out.
+ * @return The number of parsed numbers.
+ */
+template<ParseMode Mode = ParseMode::Validated, std::size_t MaxDigits = 19>
+std::size_t parseInts(std::string_view line, const char delimiter, std::span<std::int64_t> out) {
+    std::size_t count = 0;
+    while ( !line.empty() ) {
+        if constexpr ( Mode == ParseMode::Validated ) {
+            throwIfInvalid(count < out.size(), "Too many numbers");
+        } //if constexpr ( Mode == ParseMode::Validated )
+
+        const auto [value, length] = parseIntPrefix<Mode, MaxDigits>(line);
+        if constexpr ( Mode == ParseMode::Validated ) {
+            throwIfInvalid(length != 0 && (length == line.size() || line[length] == delimiter), "Not a number");
+        } //if constexpr ( Mode == ParseMode::Validated )
+        out[count++] = value;
+        line.remove_prefix(std::min(length + 1, line.size()));
+    } //while ( !line.empty() )
+    return count;
+}
+
+template<ParseMode Mode = ParseMode::Validated, std::size_t MaxDigits = 19>
+void parseInts(std::string_view line, const char delimiter, std::vector<std::int64_t>& out) {
+    while ( !line.empty() ) {
+        const auto [value, length] = parseIntPrefix<Mode, MaxDigits>(line);
+        if constexpr ( Mode == ParseMode::Validated ) {
+            throwIfInvalid(length != 0 && (length == line.size() || line[length] == delimiter), "Not a number");
+        } //if constexpr ( Mode == ParseMode::Validated )
+        out.push_back(value);
+        line.remove_prefix(std::min(length + 1, line.size()));
+    } //while ( !line.empty() )
+    return;
+}
+
 template<int Base = 10>
 inline std::optional<std::int64_t> convertOptionally(std::string_view input) {
     if ( Base == 10 && !std::isdigit(input[0]) && input[0] != '-' ) {
         return std::nullopt;
     } //if ( Base == 10 && !std::isdigit(input[0]) && input[0] != '-' )
 
+    if constexpr ( Base == 10 ) {
+        const auto [value, length] = parseIntPrefix(input);
+        throwIfInvalid(length != 0);
+        return value;
+    } //if constexpr ( Base == 10 )
+
     std::int64_t ret    = 0;
     auto         result = std::from_chars(input.begin(), input.end(), ret, Base);
     throwIfInvalid(result.ec == std::errc{});
@@ -267,15 +447,6 @@ inline double convertDouble(std::string_view input) {
     return ret;
 }
 
-template<std::integral T>
-void Coordinate<T>::setMaxFromMap(MapView map) {
-    throwIfInvalid(!map.Base.empty());
-    throwIfInvalid(!map.Base.front().empty());
-    MaxRow    = static_cast<T>(map.Base.size());
-    MaxColumn = static_cast<T>(map.Base.front().size());
-    return;
-}
-
 template<typename Range, typename ReturnType = const std::ranges::range_value_t<Range>&>
 std::generator<std::pair<ReturnType, ReturnType>> symmetricCartesianProduct(Range&& range) noexcept {
     auto begin = std::ranges::begin(range);
@@ -288,6 +459,387 @@ std::generator<std::pair<ReturnType, ReturnType>> symmetricCartesianProduct(Rang
     } //for ( auto i = begin; i != end; ++i )
 }
 
+namespace FlatHash {
+/**
+ * @brief An open addressing hash table with linear probing and backward shift deletion.
+ *
+ * The hash is mixed again before use, so identity hashes like std::hash<std::int64_t> work fine. Values have to be
+ * default constructible, empty slots hold a default constructed value.
+ */
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+class Table {
+    public:
+    using Key = std::remove_cvref_t<std::invoke_result_t<KeyOf, const Value&>>;
+
+    template<bool Const>
+    class Iterator {
+        using Owner = std::conditional_t<Const, const Table, Table>;
+
+        public:
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type       = Value;
+        using difference_type  = std::ptrdiff_t;
+        using reference        = std::conditional_t<Const, const Value&, Value&>;
+        using pointer          = std::conditional_t<Const, const Value*, Value*>;
+
+        Iterator(void) noexcept = default;
+
+        Iterator(Owner* owner, std::size_t slot) noexcept : TheOwner{owner}, Slot{slot} {
+            skipUnused();
+            return;
+        }
+
+        reference operator*(void) const noexcept {
+            return TheOwner->Slots[Slot];
+        }
+
+        pointer operator->(void) const noexcept {
+            return &TheOwner->Slots[Slot];
+        }
+
+        Iterator& operator++(void) noexcept {
+            ++Slot;
+            skipUnused();
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            auto ret{*this};
+            ++*this;
+            return ret;
+        }
+
+        bool operator==(const Iterator&) const noexcept = default;
+
+        private:
+        Owner*      TheOwner = nullptr;
+        std::size_t Slot     = 0;
+
+        void skipUnused(void) noexcept {
+            while ( Slot < TheOwner->Used.size() && !TheOwner->Used[Slot] ) {
+                ++Slot;
+            } //while ( Slot < TheOwner->Used.size() && !TheOwner->Used[Slot] )
+            return;
+        }
+    };
+
+    using iterator       = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    std::size_t size(void) const noexcept {
+        return Size;
+    }
+
+    bool empty(void) const noexcept {
+        return Size == 0;
+    }
+
+    void clear(void) noexcept {
+        std::ranges::fill(Slots, Value{});
+        std::ranges::fill(Used, std::uint8_t{0});
+        Size = 0;
+        return;
+    }
+
+    void reserve(std::size_t count) {
+        //Keep the load factor at most 3/4.
+        const auto capacity = std::bit_ceil(std::max<std::size_t>(16, (count * 4 + 2) / 3));
+        if ( capacity > Slots.size() ) {
+            rehash(capacity);
+        } //if ( capacity > Slots.size() )
+        return;
+    }
+
+    iterator begin(void) noexcept {
+        return {this, 0};
+    }
+
+    iterator end(void) noexcept {
+        return {this, Slots.size()};
+    }
+
+    const_iterator begin(void) const noexcept {
+        return {this, 0};
+    }
+
+    const_iterator end(void) const noexcept {
+        return {this, Slots.size()};
+    }
+
+    iterator find(const Key& key) noexcept {
+        if ( Size == 0 ) {
+            return end();
+        } //if ( Size == 0 )
+        const auto slot = findSlot(key);
+        return Used[slot] ? iterator{this, slot} : end();
+    }
+
+    const_iterator find(const Key& key) const noexcept {
+        if ( Size == 0 ) {
+            return end();
+        } //if ( Size == 0 )
+        const auto slot = findSlot(key);
+        return Used[slot] ? const_iterator{this, slot} : end();
+    }
+
+    bool contains(const Key& key) const noexcept {
+        return Size != 0 && Used[findSlot(key)];
+    }
+
+    std::pair<iterator, bool> insert(Value value) {
+        if ( (Size + 1) * 4 > Slots.size() * 3 ) {
+            rehash(std::max<std::size_t>(16, Slots.size() * 2));
+        } //if ( (Size + 1) * 4 > Slots.size() * 3 )
+
+        const auto slot = findSlot(KeyOf{}(value));
+        if ( Used[slot] ) {
+            return {iterator{this, slot}, false};
+        } //if ( Used[slot] )
+
+        Slots[slot] = std::move(value);
+        Used[slot]  = 1;
+        ++Size;
+        return {iterator{this, slot}, true};
+    }
+
+    bool erase(const Key& key) noexcept {
+        if ( Size == 0 ) {
+            return false;
+        } //if ( Size == 0 )
+
+        auto hole = findSlot(key);
+        if ( !Used[hole] ) {
+            return false;
+        } //if ( !Used[hole] )
+
+        //Move every following entry of the probe sequence, which may live in the hole, into it.
+        for ( auto slot = (hole + 1) & Mask; Used[slot]; slot = (slot + 1) & Mask ) {
+            const auto probeLength = (slot - home(KeyOf{}(Slots[slot]))) & Mask;
+            if ( probeLength >= ((slot - hole) & Mask) ) {
+                Slots[hole] = std::move(Slots[slot]);
+                hole        = slot;
+            } //if ( probeLength >= ((slot - hole) & Mask) )
+        } //for ( auto slot = (hole + 1) & Mask; Used[slot]; slot = (slot + 1) & Mask )
+
+        Slots[hole] = Value{};
+        Used[hole]  = 0;
+        --Size;
+        return true;
+    }
+
+    private:
+    std::vector<Value>        Slots;
+    std::vector<std::uint8_t> Used;
+    std::size_t               Size = 0;
+    std::size_t               Mask = 0;
+
+    std::size_t home(const Key& key) const noexcept {
+        return static_cast<std::size_t>(mixHash(static_cast<std::uint64_t>(Hash{}(key)))) & Mask;
+    }
+
+    /**
+     * @brief The slot holding key, or the empty slot where it would be inserted. Requires at least one empty slot.
+     */
+    std::size_t findSlot(const Key& key) const noexcept {
+        auto slot = home(key);
+        while ( Used[slot] && !KeyEqual{}(KeyOf{}(Slots[slot]), key) ) {
+            slot = (slot + 1) & Mask;
+        } //while ( Used[slot] && !KeyEqual{}(KeyOf{}(Slots[slot]), key) )
+        return slot;
+    }
+
+    void rehash(std::size_t capacity) {
+        auto oldSlots = std::exchange(Slots, std::vector<Value>(capacity));
+        auto oldUsed  = std::exchange(Used, std::vector<std::uint8_t>(capacity, 0));
+        Mask          = capacity - 1;
+        for ( std::size_t slot = 0; slot < oldSlots.size(); ++slot ) {
+            if ( oldUsed[slot] ) {
+                const auto newSlot = findSlot(KeyOf{}(oldSlots[slot]));
+                Slots[newSlot]     = std::move(oldSlots[slot]);
+                Used[newSlot]      = 1;
+            } //if ( oldUsed[slot] )
+        } //for ( std::size_t slot = 0; slot < oldSlots.size(); ++slot )
+        return;
+    }
+};
+
+struct First {
+    template<typename Pair>
+    static const auto& operator()(const Pair& pair) noexcept {
+        return pair.first;
+    }
+};
+} //namespace FlatHash
+
+template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashSet : FlatHash::Table<Key, std::identity, Hash, KeyEqual> {
+    using Base = FlatHash::Table<Key, std::identity, Hash, KeyEqual>;
+
+    public:
+    using iterator = typename Base::const_iterator;
+
+    using Base::clear;
+    using Base::contains;
+    using Base::empty;
+    using Base::erase;
+    using Base::reserve;
+    using Base::size;
+
+    iterator begin(void) const noexcept {
+        return Base::begin();
+    }
+
+    iterator end(void) const noexcept {
+        return Base::end();
+    }
+
+    iterator find(const Key& key) const noexcept {
+        return Base::find(key);
+    }
+
+    bool insert(Key key) {
+        return Base::insert(std::move(key)).second;
+    }
+};
+
+template<typename Key, typename Mapped, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap : public FlatHash::Table<std::pair<Key, Mapped>, FlatHash::First, Hash, KeyEqual> {
+    using Base = FlatHash::Table<std::pair<Key, Mapped>, FlatHash::First, Hash, KeyEqual>;
+
+    public:
+    Mapped& operator[](const Key& key) {
+        if ( auto iter = Base::find(key); iter != Base::end() ) {
+            return iter->second;
+        } //if ( auto iter = Base::find(key); iter != Base::end() )
+        return Base::insert({key, Mapped{}}).first->second;
+    }
+};
+
+/**
+ * @brief Union-find over the elements [0, size), with union by size and path halving.
+ */
+class DisjointSet {
+    public:
+    explicit DisjointSet(std::size_t size) : Parent(size), Size(size, 1), Components{size} {
+        std::iota(Parent.begin(), Parent.end(), 0uz);
+        return;
+    }
+
+    std::size_t size(void) const noexcept {
+        return Parent.size();
+    }
+
+    std::size_t components(void) const noexcept {
+        return Components;
+    }
+
+    /**
+     * @brief The representative of the component of element, shortens the path on the way.
+     */
+    std::size_t find(std::size_t element) noexcept {
+        while ( Parent[element] != element ) {
+            Parent[element] = Parent[Parent[element]];
+            element         = Parent[element];
+        } //while ( Parent[element] != element )
+        return element;
+    }
+
+    bool connected(std::size_t element1, std::size_t element2) noexcept {
+        return find(element1) == find(element2);
+    }
+
+    std::size_t sizeOf(std::size_t element) noexcept {
+        return Size[find(element)];
+    }
+
+    /**
+     * @brief Joins the components of both elements, returns false if they already were the same.
+     */
+    bool unite(std::size_t element1, std::size_t element2) noexcept {
+        auto root1 = find(element1);
+        auto root2 = find(element2);
+        if ( root1 == root2 ) {
+            return false;
+        } //if ( root1 == root2 )
+
+        if ( Size[root1] < Size[root2] ) {
+            std::swap(root1, root2);
+        } //if ( Size[root1] < Size[root2] )
+        Parent[root2]  = root1;
+        Size[root1]   += Size[root2];
+        --Components;
+        return true;
+    }
+
+    /**
+     * @brief The sizes of all components, in no order.
+     */
+    std::vector<std::size_t> componentSizes(void) const {
+        std::vector<std::size_t> ret;
+        ret.reserve(Components);
+        for ( std::size_t element = 0; element < Parent.size(); ++element ) {
+            if ( Parent[element] == element ) {
+                ret.push_back(Size[element]);
+            } //if ( Parent[element] == element )
+        } //for ( std::size_t element = 0; element < Parent.size(); ++element )
+        return ret;
+    }
+
+    private:
+    std::vector<std::size_t> Parent;
+    std::vector<std::size_t> Size;
+    std::size_t              Components;
+};
+
+struct PhaseTiming {
+    std::string_view                      Name;
+    std::chrono::steady_clock::time_point Start;
+    std::chrono::nanoseconds              Duration;
+    std::size_t                           Depth;
+};
+
+using PhaseLog = std::vector<PhaseTiming>;
+
+/**
+ * @brief Records the phases of the current thread into the given log, as long as the object lives.
+ */
+class PhaseRecording {
+    public:
+    explicit PhaseRecording(PhaseLog& log) noexcept;
+    PhaseRecording(const PhaseRecording&)            = delete;
+    PhaseRecording& operator=(const PhaseRecording&) = delete;
+    ~PhaseRecording(void);
+
+    private:
+    PhaseLog* Previous;
+};
+
+/**
+ * @brief Marks its lifetime as a phase, if a PhaseRecording is active. The name has to outlive the log.
+ */
+class ScopedPhase {
+    public:
+    explicit ScopedPhase(std::string_view name);
+    ScopedPhase(const ScopedPhase&)            = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+    ~ScopedPhase(void);
+
+    private:
+    PhaseLog*   Log;
+    std::size_t Index;
+};
+
+template<typename Function, typename... Args>
+decltype(auto) timePhase(std::string_view name, Function&& function, Args&&... args) {
+    ScopedPhase phase{name};
+    return std::invoke(std::forward<Function>(function), std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Sums up the durations of the phases per name, in the order of their first appearance.
+ */
+std::vector<std::pair<std::string_view, std::chrono::nanoseconds>> aggregatePhases(const PhaseLog& log);
+
 inline auto now(void) noexcept {
     return std::chrono::system_clock::now();
 }
@@ -0,0 +1,271 @@
+#ifndef JPS_HPP
+#define JPS_HPP
+
+#include "astar.hpp"
+#include "helper.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace AStar {
+enum class Connectivity : std::uint8_t {
+    Four,  ///< Only orthogonal moves.
+    Eight, ///< Diagonal moves too, if both orthogonal cells next to the move are passable.
+};
+
+template<typename Function, typename Position>
+concept PassableFunctionFor = requires(const Function& f, Position p) {
+                                  { f(p) } noexcept -> std::same_as<bool>;
+                              };
+
+namespace Jps {
+template<std::integral T>
+struct JumpPoint {
+    Coordinate<T> Pos;
+    std::int64_t  Cost;
+};
+
+template<std::integral T>
+CoordinateOffset<T> directionOf(CoordinateOffset<T> offset) noexcept {
+    return {static_cast<T>((offset.Row > 0) - (offset.Row < 0)),
+            static_cast<T>((offset.Column > 0) - (offset.Column < 0))};
+}
+
+/**
+ * @brief Implements the pruning and jumping of Jump Point Search, for uniform cost grids.
+ *
+ * The cost of a jump is the sum of costFunction over its single steps.
+ */
+template<Connectivity Moves, std::integral T, typename CostFunction, typename PassableFunction>
+class Jumper {
+    public:
+    using Position  = Coordinate<T>;
+    using Direction = CoordinateOffset<T>;
+
+    Jumper(const Position& end, const CostFunction& costFunction, const PassableFunction& passableFunction) noexcept :
+            End{end}, Cost{costFunction}, Passable{passableFunction} {
+        return;
+    }
+
+    /**
+     * @brief The directions worth exploring from position, when it was reached moving in direction.
+     * @param direction The move into position, {0, 0} for the start.
+     */
+    std::vector<Direction> prunedDirections(const Position& position, Direction direction) const {
+        std::vector<Direction> ret;
+        auto addIfPassable = [this, &position, &ret](Direction next) {
+            if ( Passable(position + next) ) {
+                ret.push_back(next);
+            } //if ( Passable(position + next) )
+            return;
+        };
+
+        if ( direction == Direction{0, 0} ) {
+            for ( const auto next : allDirections() ) {
+                if ( canMove(position, next) ) {
+                    ret.push_back(next);
+                } //if ( canMove(position, next) )
+            } //for ( const auto next : allDirections() )
+            return ret;
+        } //if ( direction == Direction{0, 0} )
+
+        if ( direction.Row != 0 && direction.Column != 0 ) {
+            const Direction vertical{direction.Row, 0};
+            const Direction horizontal{0, direction.Column};
+            addIfPassable(vertical);
+            addIfPassable(horizontal);
+            if ( canMove(position, direction) ) {
+                ret.push_back(direction);
+            } //if ( canMove(position, direction) )
+            return ret;
+        } //if ( direction.Row != 0 && direction.Column != 0 )
+
+        //Straight, the directions to the sides are always of interest, the cells behind could have been blocked.
+        const Direction side{direction.Column, direction.Row};
+        const Direction otherSide = side * T{-1};
+        addIfPassable(direction);
+        addIfPassable(side);
+        addIfPassable(otherSide);
+        if constexpr ( Moves == Connectivity::Eight ) {
+            if ( canMove(position, direction + side) ) {
+                ret.push_back(direction + side);
+            } //if ( canMove(position, direction + side) )
+            if ( canMove(position, direction + otherSide) ) {
+                ret.push_back(direction + otherSide);
+            } //if ( canMove(position, direction + otherSide) )
+        } //if constexpr ( Moves == Connectivity::Eight )
+        return ret;
+    }
+
+    /**
+     * @brief Moves from position in direction until reaching a jump point, or a dead end.
+     */
+    std::optional<JumpPoint<T>> jump(Position position, Direction direction) const {
+        if ( direction.Row != 0 && direction.Column != 0 ) {
+            return jumpDiagonal(position, direction);
+        } //if ( direction.Row != 0 && direction.Column != 0 )
+        return jumpStraight(position, direction);
+    }
+
+    private:
+    const Position&         End;
+    const CostFunction&     Cost;
+    const PassableFunction& Passable;
+
+    static auto allDirections(void) noexcept {
+        if constexpr ( Moves == Connectivity::Four ) {
+            return std::array{Direction{-1, 0}, Direction{0, 1}, Direction{1, 0}, Direction{0, -1}};
+        } //if constexpr ( Moves == Connectivity::Four )
+        else {
+            return std::array{Direction{-1, 0}, Direction{0, 1},  Direction{1, 0},  Direction{0, -1},
+                              Direction{-1, 1}, Direction{1, 1},  Direction{1, -1}, Direction{-1, -1}};
+        } //else -> if constexpr ( Moves == Connectivity::Four )
+    }
+
+    bool canMove(const Position& position, Direction direction) const noexcept {
+        if ( direction.Row != 0 && direction.Column != 0 ) {
+            return Passable(position + Direction{direction.Row, 0}) &&
+                   Passable(position + Direction{0, direction.Column}) && Passable(position + direction);
+        } //if ( direction.Row != 0 && direction.Column != 0 )
+        return Passable(position + direction);
+    }
+
+    /**
+     * @brief Whether a straight move in direction passes a cell next to position, which became reachable just now.
+     */
+    bool hasForcedNeighbor(const Position& position, Direction direction) const noexcept {
+        const Direction side{direction.Column, direction.Row};
+        const Direction otherSide = side * T{-1};
+        return (Passable(position + side) && !Passable(position + side - direction)) ||
+               (Passable(position + otherSide) && !Passable(position + otherSide - direction));
+    }
+
+    std::optional<JumpPoint<T>> jumpStraight(Position position, Direction direction) const {
+        std::int64_t cost = 0;
+        while ( true ) {
+            const auto next = position + direction;
+            if ( !Passable(next) ) {
+                return std::nullopt;
+            } //if ( !Passable(next) )
+            cost     += Cost(position, next);
+            position  = next;
+
+            if ( position == End || hasForcedNeighbor(position, direction) ) {
+                return JumpPoint<T>{position, cost};
+            } //if ( position == End || hasForcedNeighbor(position, direction) )
+
+            if constexpr ( Moves == Connectivity::Four ) {
+                //Moving vertically, every turn into a horizontal jump point makes this a jump point.
+                if ( direction.Row != 0 && (jumpStraight(position, {0, 1}) || jumpStraight(position, {0, -1})) ) {
+                    return JumpPoint<T>{position, cost};
+                } //if ( direction.Row != 0 && (jumpStraight(position, {0, 1}) || jumpStraight(position, {0, -1})) )
+            } //if constexpr ( Moves == Connectivity::Four )
+        } //while ( true )
+    }
+
+    std::optional<JumpPoint<T>> jumpDiagonal(Position position, Direction direction) const {
+        const Direction vertical{direction.Row, 0};
+        const Direction horizontal{0, direction.Column};
+        std::int64_t    cost = 0;
+        while ( canMove(position, direction) ) {
+            const auto next  = position + direction;
+            cost            += Cost(position, next);
+            position         = next;
+
+            if ( position == End || jumpStraight(position, vertical) || jumpStraight(position, horizontal) ) {
+                return JumpPoint<T>{position, cost};
+            } //if ( position == End || jumpStraight(position, vertical) || jumpStraight(position, horizontal) )
+        } //while ( canMove(position, direction) )
+        return std::nullopt;
+    }
+};
+} //namespace Jps
+
+/**
+ * @brief A* with Jump Point Search on a uniform cost grid.
+ *
+ * Instead of every neighbor only the jump points are queued, where an optimal path may turn. costFunction is called
+ * for the single steps, it has to be the same for every step of one kind (straight or diagonal), otherwise the
+ * pruning is not exact. passableFunction has to return false outside of the grid. Returned paths contain every cell,
+ * like the ones of search(). Mode::AllPaths is not supported, the pruning removes the equally short alternatives.
+ */
+template<Mode TheMode, Connectivity Moves, OpenSet Queue = IndexedHeap<>, std::integral T,
+         CostFunctionFor<Coordinate<T>> CostFunction, PassableFunctionFor<Coordinate<T>> PassableFunction,
+         CostFunctionFor<Coordinate<T>> HeuristicFunction,
+         StatesFor<Coordinate<T>>       States     = HashedStates<Coordinate<T>>,
+         StatisticsPolicy               Statistics = NoStatistics>
+requires (TheMode != Mode::AllPaths)
+AStarResult<TheMode, Coordinate<T>>
+searchJumpPoints(const Coordinate<T>& start, const Coordinate<T>& end, const CostFunction& costFunction,
+                 const PassableFunction& passableFunction, const HeuristicFunction& heuristicFunction,
+                 States states = {}, Statistics& statistics = noStatistics) {
+    using Position = Coordinate<T>;
+
+    statistics.searchStarted();
+    if ( start == end ) {
+        statistics.searchFinished(0);
+        return trivialResult<TheMode>(end, costFunction(end, end));
+    } //if ( start == end )
+
+    const Jps::Jumper<Moves, T, CostFunction, PassableFunction> jumper{end, costFunction, passableFunction};
+    NodeArena<TheMode, Position, States>                        nodes{std::move(states)};
+    Queue                                                       queue;
+    std::size_t                                                 endNode = NoNode;
+
+    queue.push(nodes.relax(start, 0, NoNode), heuristicFunction(start, end), 0);
+    statistics.queued(queue.size());
+
+    while ( const auto current = queue.pop() ) {
+        const auto& node     = nodes[current->Node];
+        const auto  position = node.Pos;
+        const auto  cost     = node.Cost;
+        if ( position == end ) {
+            endNode = current->Node;
+            break;
+        } //if ( position == end )
+
+        statistics.expanded();
+        const auto direction = node.Parent == NoNode ? CoordinateOffset<T>{0, 0}
+                                                     : Jps::directionOf(position - nodes[node.Parent].Pos);
+        for ( const auto next : jumper.prunedDirections(position, direction) ) {
+            if ( const auto jumpPoint = jumper.jump(position, next) ) {
+                const auto nextCost = cost + jumpPoint->Cost;
+                if ( const auto nextNode = nodes.relax(jumpPoint->Pos, nextCost, current->Node); nextNode != NoNode ) {
+                    queue.push(nextNode, nextCost + heuristicFunction(jumpPoint->Pos, end), nextCost);
+                    statistics.queued(queue.size());
+                } //if ( const auto nextNode = nodes.relax(jumpPoint->Pos, nextCost, current->Node); ... )
+            } //if ( const auto jumpPoint = jumper.jump(position, next) )
+        } //for ( const auto next : jumper.prunedDirections(position, direction) )
+    } //while ( const auto current = queue.pop() )
+    statistics.searchFinished(queue.stalePops());
+
+    AStarResult<TheMode, Position> result{{}, -1};
+    if ( endNode == NoNode ) {
+        return result;
+    } //if ( endNode == NoNode )
+
+    result.Cost = nodes[endNode].Cost;
+    if constexpr ( TheMode == Mode::ReturnPath ) {
+        //Fill in the cells between the jump points, they lie on straight or diagonal lines.
+        Path<TheMode, Position> path;
+        Position                from = start;
+        for ( const auto& jumpPoint : nodes.pathTo(endNode) ) {
+            const auto step = Jps::directionOf(jumpPoint - from);
+            while ( from != jumpPoint ) {
+                from += step;
+                path.push_back(from);
+            } //while ( from != jumpPoint )
+        } //for ( const auto& jumpPoint : nodes.pathTo(endNode) )
+        result.Paths.push_back(std::move(path));
+    } //if constexpr ( TheMode == Mode::ReturnPath )
+    else {
+        result.Paths.emplace_back();
+    } //else -> if constexpr ( TheMode == Mode::ReturnPath )
+    return result;
+}
+} //namespace AStar
+
+#endif //JPS_HPP
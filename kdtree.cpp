@@ -0,0 +1,178 @@
+#include "kdtree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <span>
+
+namespace {
+constexpr std::size_t LeafSize = 16;
+constexpr std::size_t TileSize = 1024;
+
+std::int64_t axisValue(const Coordinate3D<std::int64_t>& point, std::size_t axis) noexcept {
+    switch ( axis % 3 ) {
+        case 0  : return point.X;
+        case 1  : return point.Y;
+        default : return point.Z;
+    } //switch ( axis % 3 )
+}
+
+bool closer(const KdTree::Neighbor& lhs, const KdTree::Neighbor& rhs) noexcept {
+    return lhs.SquaredDistance < rhs.SquaredDistance ||
+           (lhs.SquaredDistance == rhs.SquaredDistance && lhs.Index < rhs.Index);
+}
+
+void build(const PointCloud& points, std::span<std::size_t> order, std::size_t depth) {
+    if ( order.size() <= LeafSize ) {
+        return;
+    } //if ( order.size() <= LeafSize )
+
+    const auto middle = order.size() / 2;
+    std::ranges::nth_element(order, order.begin() + static_cast<std::ptrdiff_t>(middle), {},
+                             [&points, depth](std::size_t index) noexcept { return axisValue(points[index], depth); });
+    build(points, order.first(middle), depth + 1);
+    build(points, order.subspan(middle + 1), depth + 1);
+    return;
+}
+
+/**
+ * @brief Keeps the k closest points as max heap, the indices are positions in the tree.
+ */
+struct NearestCollector {
+    std::size_t                    Self;
+    std::size_t                    K;
+    std::vector<KdTree::Neighbor>& Heap; //NOLINT
+
+    std::uint64_t bound(void) const noexcept {
+        return Heap.size() < K ? std::numeric_limits<std::uint64_t>::max() : Heap.front().SquaredDistance;
+    }
+
+    void add(std::size_t position, std::uint64_t squaredDistance) {
+        const KdTree::Neighbor neighbor{squaredDistance, position};
+        if ( position == Self ) {
+            return;
+        } //if ( position == Self )
+
+        if ( Heap.size() < K ) {
+            Heap.push_back(neighbor);
+            std::ranges::push_heap(Heap, closer);
+        } //if ( Heap.size() < K )
+        else if ( closer(neighbor, Heap.front()) ) {
+            std::ranges::pop_heap(Heap, closer);
+            Heap.back() = neighbor;
+            std::ranges::push_heap(Heap, closer);
+        } //else if ( closer(neighbor, Heap.front()) )
+        return;
+    }
+};
+
+struct WithinCollector {
+    std::size_t                    Self;
+    std::uint64_t                  Limit;
+    std::vector<KdTree::Neighbor>& Found; //NOLINT
+
+    std::uint64_t bound(void) const noexcept {
+        return Limit;
+    }
+
+    void add(std::size_t position, std::uint64_t squaredDistance) {
+        if ( position != Self && squaredDistance < Limit ) {
+            Found.push_back({squaredDistance, position});
+        } //if ( position != Self && squaredDistance < Limit )
+        return;
+    }
+};
+} //namespace
+
+KdTree::KdTree(const PointCloud& points) : Original(points.size()), Position(points.size()) {
+    std::iota(Original.begin(), Original.end(), 0uz);
+    build(points, Original, 0);
+
+    TreePoints.reserve(points.size());
+    for ( std::size_t position = 0; position < Original.size(); ++position ) {
+        TreePoints.push_back(points[Original[position]]);
+        Position[Original[position]] = position;
+    } //for ( std::size_t position = 0; position < Original.size(); ++position )
+    return;
+}
+
+template<typename Visitor>
+void KdTree::visit(std::size_t first, std::size_t last, std::size_t depth, const Coordinate3D<std::int64_t>& query,
+                   Visitor& visitor) const {
+    if ( last - first <= LeafSize ) {
+        std::array<std::uint64_t, LeafSize> distances;
+        const auto                          leaf = std::span{distances}.first(last - first);
+        squaredDistances(TreePoints, query, first, leaf);
+        for ( std::size_t i = 0; i < leaf.size(); ++i ) {
+            visitor.add(first + i, leaf[i]);
+        } //for ( std::size_t i = 0; i < leaf.size(); ++i )
+        return;
+    } //if ( last - first <= LeafSize )
+
+    //The split point is the node itself, every point left of it is at most, every point right of it at least as
+    //large on this axis.
+    const auto    middle = first + (last - first) / 2;
+    std::uint64_t nodeDistance;
+    squaredDistances(TreePoints, query, middle, std::span{&nodeDistance, 1});
+    visitor.add(middle, nodeDistance);
+
+    const auto diff     = axisValue(query, depth) - axisValue(TreePoints[middle], depth);
+    const auto distance = static_cast<std::uint64_t>(diff) * static_cast<std::uint64_t>(diff);
+    if ( diff < 0 ) {
+        visit(first, middle, depth + 1, query, visitor);
+        if ( distance < visitor.bound() ) {
+            visit(middle + 1, last, depth + 1, query, visitor);
+        } //if ( distance < visitor.bound() )
+    } //if ( diff < 0 )
+    else {
+        visit(middle + 1, last, depth + 1, query, visitor);
+        if ( distance < visitor.bound() ) {
+            visit(first, middle, depth + 1, query, visitor);
+        } //if ( distance < visitor.bound() )
+    } //else -> if ( diff < 0 )
+    return;
+}
+
+void KdTree::nearest(std::size_t index, std::size_t k, std::vector<Neighbor>& out) const {
+    out.clear();
+    if ( k == 0 || Original.empty() ) {
+        return;
+    } //if ( k == 0 || Original.empty() )
+
+    NearestCollector collector{Position[index], k, out};
+    visit(0, Original.size(), 0, TreePoints[Position[index]], collector);
+    std::ranges::sort_heap(out, closer);
+    for ( auto& neighbor : out ) {
+        neighbor.Index = Original[neighbor.Index];
+    } //for ( auto& neighbor : out )
+    return;
+}
+
+void KdTree::nearestOfAll(std::size_t k, std::span<Neighbor> out, ThreadPool& pool) const {
+    parallelFor(pool, Original.size(), TileSize, [this, k, out](std::size_t first, std::size_t last) {
+        //Consecutive positions in the tree are close to each other, so a tile mostly visits the same nodes.
+        std::vector<Neighbor> nearest;
+        for ( std::size_t position = first; position < last; ++position ) {
+            const auto index = Original[position];
+            this->nearest(index, k, nearest);
+            std::ranges::copy(nearest, out.begin() + static_cast<std::ptrdiff_t>(index * k));
+        } //for ( std::size_t position = first; position < last; ++position )
+        return;
+    });
+    return;
+}
+
+void KdTree::within(std::size_t index, std::uint64_t limit, std::vector<Neighbor>& out) const {
+    out.clear();
+    if ( Original.empty() ) {
+        return;
+    } //if ( Original.empty() )
+
+    WithinCollector collector{Position[index], limit, out};
+    visit(0, Original.size(), 0, TreePoints[Position[index]], collector);
+    for ( auto& neighbor : out ) {
+        neighbor.Index = Original[neighbor.Index];
+    } //for ( auto& neighbor : out )
+    return;
+}
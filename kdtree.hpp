@@ -0,0 +1,58 @@
+#ifndef KDTREE_HPP
+#define KDTREE_HPP
+
+#include "pointcloud.hpp"
+#include "threadpool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @brief A static, implicit k-d tree over the points of a PointCloud.
+ *
+ * The points are reordered, so that every leaf is a contiguous run, whose distances are computed with the vectorized
+ * squaredDistances(). All queries are by the index of a point in the original cloud and never report the point itself.
+ */
+class KdTree {
+    public:
+    struct Neighbor {
+        std::uint64_t SquaredDistance;
+        std::size_t   Index;
+    };
+
+    explicit KdTree(const PointCloud& points);
+
+    std::size_t size(void) const noexcept {
+        return Original.size();
+    }
+
+    /**
+     * @brief Replaces out by the k nearest neighbors of points[index], the nearest first.
+     */
+    void nearest(std::size_t index, std::size_t k, std::vector<Neighbor>& out) const;
+
+    /**
+     * @brief Writes the k nearest neighbors of every point to out, those of points[i] to out[i * k, (i + 1) * k).
+     *
+     * k has to be less than size(). The queries are split into tiles of neighboring points, which run on pool.
+     */
+    void nearestOfAll(std::size_t k, std::span<Neighbor> out, ThreadPool& pool) const;
+
+    /**
+     * @brief Replaces out by all points with a squared distance to points[index] less than limit, in no order.
+     */
+    void within(std::size_t index, std::uint64_t limit, std::vector<Neighbor>& out) const;
+
+    private:
+    PointCloud               TreePoints;
+    std::vector<std::size_t> Original;
+    std::vector<std::size_t> Position;
+
+    template<typename Visitor>
+    void visit(std::size_t first, std::size_t last, std::size_t depth, const Coordinate3D<std::int64_t>& query,
+               Visitor& visitor) const;
+};
+
+#endif //KDTREE_HPP
@@ -0,0 +1,103 @@
+#include "lineindex.hpp"
+
+#include <bit>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #define LINEINDEX_X86
+  #include <immintrin.h>
+#endif
+
+namespace {
+struct Emitter {
+    std::string_view               Data;
+    bool                           SkipEmpty;
+    std::vector<std::string_view>& Parts; //NOLINT
+    std::size_t                    Start = 0;
+
+    void emit(std::size_t end) {
+        if ( !SkipEmpty || end != Start ) {
+            Parts.emplace_back(Data.data() + Start, end - Start);
+        } //if ( !SkipEmpty || end != Start )
+        Start = end + 1;
+        return;
+    }
+
+    void emitMask(std::uint32_t mask, std::size_t base) {
+        for ( ; mask; mask &= mask - 1 ) {
+            emit(base + static_cast<std::size_t>(std::countr_zero(mask)));
+        } //for ( ; mask; mask &= mask - 1 )
+        return;
+    }
+
+    void finish(std::size_t from, char delimiter) {
+        for ( auto i = from; i < Data.size(); ++i ) {
+            if ( Data[i] == delimiter ) {
+                emit(i);
+            } //if ( Data[i] == delimiter )
+        } //for ( auto i = from; i < Data.size(); ++i )
+
+        if ( !Data.empty() && (!SkipEmpty || Start != Data.size()) ) {
+            Parts.emplace_back(Data.data() + Start, Data.size() - Start);
+        } //if ( !Data.empty() && (!SkipEmpty || Start != Data.size()) )
+        return;
+    }
+};
+
+void indexScalar(std::string_view data, char delimiter, bool skipEmpty, std::vector<std::string_view>& parts) {
+    Emitter emitter{data, skipEmpty, parts};
+    emitter.finish(0, delimiter);
+    return;
+}
+
+#ifdef LINEINDEX_X86
+__attribute__((target("sse2"))) void indexSse2(std::string_view data, char delimiter, bool skipEmpty,
+                                               std::vector<std::string_view>& parts) {
+    Emitter     emitter{data, skipEmpty, parts};
+    const auto  needle = _mm_set1_epi8(delimiter);
+    std::size_t i      = 0;
+    for ( ; i + 16 <= data.size(); i += 16 ) {
+        //NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + i));
+        emitter.emitMask(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))), i);
+    } //for ( ; i + 16 <= data.size(); i += 16 )
+    emitter.finish(i, delimiter);
+    return;
+}
+
+__attribute__((target("avx2"))) void indexAvx2(std::string_view data, char delimiter, bool skipEmpty,
+                                               std::vector<std::string_view>& parts) {
+    Emitter     emitter{data, skipEmpty, parts};
+    const auto  needle = _mm256_set1_epi8(delimiter);
+    std::size_t i      = 0;
+    for ( ; i + 32 <= data.size(); i += 32 ) {
+        //NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data.data() + i));
+        emitter.emitMask(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle))), i);
+    } //for ( ; i + 32 <= data.size(); i += 32 )
+    emitter.finish(i, delimiter);
+    return;
+}
+#endif
+
+using Kernel = void (*)(std::string_view, char, bool, std::vector<std::string_view>&);
+
+Kernel selectKernel(void) noexcept {
+#ifdef LINEINDEX_X86
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports("avx2") ) {
+        return indexAvx2;
+    } //if ( __builtin_cpu_supports("avx2") )
+    if ( __builtin_cpu_supports("sse2") ) {
+        return indexSse2;
+    } //if ( __builtin_cpu_supports("sse2") )
+#endif
+    return indexScalar;
+}
+} //namespace
+
+void indexDelimited(std::string_view data, char delimiter, bool skipEmpty, std::vector<std::string_view>& parts) {
+    static const Kernel kernel = selectKernel();
+    kernel(data, delimiter, skipEmpty, parts);
+    return;
+}
@@ -0,0 +1,22 @@
+#ifndef LINEINDEX_HPP
+#define LINEINDEX_HPP
+
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Splits data at every delimiter and appends the parts to parts, in one pass.
+ *
+ * Scans 32 (AVX2) or 16 (SSE2) bytes at once, chosen at runtime, with a scalar fallback. The parts are the same as
+ * splitString() would yield, but without the per byte iteration of std::views::split.
+ */
+void indexDelimited(std::string_view data, char delimiter, bool skipEmpty, std::vector<std::string_view>& parts);
+
+template<bool SkipEmpty = true>
+std::vector<std::string_view> splitIndexed(const std::string_view data, const char delimiter) {
+    std::vector<std::string_view> ret;
+    indexDelimited(data, delimiter, SkipEmpty, ret);
+    return ret;
+}
+
+#endif //LINEINDEX_HPP
@@ -1,3 +1,4 @@
+#include "benchmark.hpp"
 #include "challenge1.hpp"
 #include "challenge10.hpp"
 #include "challenge11.hpp"
@@ -11,22 +12,228 @@
 #include "challenge8.hpp"
 #include "challenge9.hpp"
 #include "helper.hpp"
+#include "lineindex.hpp"
+#include "mappedfile.hpp"
 #include "print.hpp"
+#include "threadpool.hpp"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
-#include <cstring>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <iterator>
+#include <ranges>
 #include <span>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 using namespace std::string_view_literals;
 
+namespace {
+using Clock             = BenchmarkClock;
+using ChallengeFunction = bool (*)(const std::vector<std::string_view>&);
+
+ChallengeFunction challengeFunction(std::int64_t challenge) noexcept {
+    switch ( challenge ) {
+        case 1  : return challenge1;
+        case 2  : return challenge2;
+        case 3  : return challenge3;
+        case 4  : return challenge4;
+        case 5  : return challenge5;
+        case 6  : return challenge6;
+        case 7  : return challenge7;
+        case 8  : return challenge8;
+        case 9  : return challenge9;
+        case 10 : return challenge10;
+        case 11 : return challenge11;
+        case 12 : return challenge12;
+    } //switch ( challenge )
+    return nullptr;
+}
+
+std::int64_t toNumber(std::string_view text) noexcept {
+    if ( text.empty() ) {
+        return 0;
+    } //if ( text.empty() )
+
+    try {
+        return convertOptionally(text).value_or(0);
+    } //try
+    catch ( ... ) {
+        return 0;
+    }
+}
+
+struct Input {
+    MappedFile                    File;
+    std::vector<std::string_view> Lines;
+};
+
+Input readInput(const std::filesystem::path& inputFilePath) {
+    if ( !std::filesystem::exists(inputFilePath) ) {
+        throw std::runtime_error{std::format("\"{:s}\" does not exist!", inputFilePath.c_str())};
+    } //if ( !std::filesystem::exists(inputFilePath) )
+
+    if ( !std::filesystem::is_regular_file(inputFilePath) ) {
+        throw std::runtime_error{std::format("\"{:s}\" is not a file!", inputFilePath.c_str())};
+    } //if ( !std::filesystem::is_regular_file(inputFilePath) )
+
+    //The lines point directly into the mapping, no copy of the content is made.
+    Input ret{.File = MappedFile{inputFilePath}, .Lines = {}};
+    indexDelimited(ret.File.content(), '\n', /*skipEmpty=*/false, ret.Lines);
+    auto lastNonEmpty = std::ranges::find_last_if_not(ret.Lines, &std::string_view::empty);
+    if ( lastNonEmpty.begin() != ret.Lines.end() ) {
+        ret.Lines.erase(std::next(lastNonEmpty.begin()), lastNonEmpty.end());
+    } //if ( lastNonEmpty.begin() != ret.Lines.end() )
+    return ret;
+}
+
+struct Options {
+    std::size_t           Jobs       = 1;
+    std::size_t           BenchRuns  = 0;
+    std::size_t           WarmUpRuns = 1;
+    std::filesystem::path TraceFile;
+    bool                  Micro = false;
+    std::string_view      MicroFilter;
+};
+
+struct ChallengeRun {
+    std::int64_t Challenge  = 0;
+    bool         Run        = false;
+    bool         Successful = false;
+    PhaseLog     Phases;
+};
+
+void printPhases(const PhaseLog& phases) {
+    if ( phases.empty() ) {
+        return;
+    } //if ( phases.empty() )
+
+    std::string text;
+    for ( const auto& [name, duration] : aggregatePhases(phases) ) {
+        std::format_to(std::back_inserter(text), "{:s}{:s} {:.3f}ms", text.empty() ? "" : ", ", name,
+                       std::chrono::duration<double, std::milli>{duration}.count());
+    } //for ( const auto& [name, duration] : aggregatePhases(phases) )
+    myPrint(" == Phases: {:s} ==\n", text);
+    return;
+}
+
+void writeChromeTrace(const std::filesystem::path& traceFile, std::span<const ChallengeRun> runs,
+                      Clock::time_point epoch) {
+    std::ofstream file{traceFile};
+    if ( !file ) {
+        myErr("Could not open \"{:s}\" for the trace!\n", traceFile.c_str());
+        return;
+    } //if ( !file )
+
+    const auto toMicroseconds = [](auto duration) noexcept {
+        return std::chrono::duration<double, std::micro>{duration}.count();
+    };
+
+    std::ostreambuf_iterator<char> out{file};
+    bool                           first = true;
+    std::format_to(out, "{{\"traceEvents\":[\n");
+    for ( const auto& run : runs ) {
+        for ( const auto& timing : run.Phases ) {
+            std::format_to(out,
+                           "{:s}{{\"name\":\"{:s}\",\"cat\":\"challenge{:d}\",\"ph\":\"X\","
+                           "\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{:d}}}",
+                           first ? "" : ",\n", timing.Name, run.Challenge, toMicroseconds(timing.Start - epoch),
+                           toMicroseconds(timing.Duration), run.Challenge);
+            first = false;
+        } //for ( const auto& timing : run.Phases )
+    } //for ( const auto& run : runs )
+    std::format_to(out, "\n]}}\n");
+    return;
+}
+
+bool benchmarkChallenge(std::int64_t challenge, ChallengeFunction function,
+                        const std::vector<std::string_view>& challengeInput, const Options& options) {
+    bool                  successful = true;
+    CapturedOutput        discarded;
+    std::vector<PhaseLog> phasesPerRun;
+    auto                  run = [function, &challengeInput, &successful, &discarded, &phasesPerRun](void) {
+        PhaseRecording recording{phasesPerRun.emplace_back()};
+        successful = function(challengeInput) && successful;
+        discarded.Out.clear();
+        discarded.Err.clear();
+        return;
+    };
+
+    const auto statistics = [&options, &run, &discarded](void) {
+        OutputCapture capture{discarded};
+        return calculateStatistics(sampleRuns(options.WarmUpRuns, options.BenchRuns, run));
+    }();
+    myPrint(" == Benchmark of Challenge {:d}: {} ==\n", challenge, statistics);
+
+    const auto aggregated = phasesPerRun | std::views::drop(options.WarmUpRuns) |
+                            std::views::transform(aggregatePhases) | std::ranges::to<std::vector>();
+    for ( const auto& [name, _] : aggregated.front() ) {
+        std::vector<std::chrono::nanoseconds> samples;
+        for ( const auto& phases : aggregated ) {
+            const auto iter = std::ranges::find(phases, name, [](const auto& entry) noexcept { return entry.first; });
+            samples.push_back(iter == phases.end() ? std::chrono::nanoseconds{} : iter->second);
+        } //for ( const auto& phases : aggregated )
+        myPrint(" == Benchmark of Phase {:s}: {} ==\n", name, calculateStatistics(std::move(samples)));
+    } //for ( const auto& [name, _] : aggregated.front() )
+    return successful;
+}
+
+ChallengeRun runChallenge(const std::filesystem::path& dataDirectory, std::string_view input, const Options& options) {
+    const auto challenge = toNumber(input);
+
+    if ( challenge == 0 ) {
+        myErr("{:s} is not a valid challenge identifier!\n", input);
+        return {};
+    } //if ( challenge == 0 )
+
+    const auto function = challengeFunction(challenge);
+
+    if ( !function ) {
+        myErr("Challenge {:d} is not known!\n", challenge);
+        return {.Challenge = challenge};
+    } //if ( !function )
+
+    try {
+        PhaseLog       phases;
+        PhaseRecording recording{phases};
+        const auto     inputFilePath  = dataDirectory / std::format("{:d}.txt", challenge);
+        const auto     inputFile      = timePhase("load", readInput, inputFilePath);
+        const auto&    challengeInput = inputFile.Lines;
+
+        myPrint(" == Starting Challenge {:d} ==\n", challenge);
+        const auto start      = Clock::now();
+        auto       successful = timePhase("solve", function, challengeInput);
+        const auto end        = Clock::now();
+        printPhases(phases);
+
+        if ( options.BenchRuns > 0 ) {
+            successful = benchmarkChallenge(challenge, function, challengeInput, options) && successful;
+        } //if ( options.BenchRuns > 0 )
+
+        if ( !successful ) {
+            myPrint("Failed\n");
+        } //if ( !successful )
+
+        const auto duration = end - start;
+        myPrint(" == End of Challenge {:d} after {} ==\n\n", challenge,
+                std::chrono::duration_cast<std::chrono::milliseconds>(duration));
+        return {.Challenge = challenge, .Run = true, .Successful = successful, .Phases = std::move(phases)};
+    } //try
+    catch ( const std::exception& e ) {
+        myErr("Skipping Challenge {:d}: {:s}\n", challenge, e.what());
+        return {.Challenge = challenge};
+    } //catch ( const std::exception& e)
+}
+} //namespace
+
 /**
  * @brief Hauptfunktion.
  * @author Björn Schäpers
@@ -36,127 +243,129 @@ using namespace std::string_view_literals;
  * @result 0 bei Erfolg.
  */
 int main(int argc, const char* argv[]) {
-    if ( argc < 3 ) {
+    Options                       options;
+    std::vector<std::string_view> arguments;
+
+    for ( int i = 1; i < argc; ++i ) {
+        const std::string_view argument{argv[i]};
+
+        if ( !argument.starts_with("--"sv) ) {
+            arguments.push_back(argument);
+            continue;
+        } //if ( !argument.starts_with("--"sv) )
+
+        if ( ++i == argc ) {
+            myErr("{:s} needs a value!\n", argument);
+            return -3;
+        } //if ( ++i == argc )
+
+        if ( argument == "--trace"sv ) {
+            options.TraceFile = argv[i];
+            continue;
+        } //if ( argument == "--trace"sv )
+
+        if ( argument == "--micro"sv ) {
+            options.Micro       = true;
+            options.MicroFilter = argv[i] == "all"sv ? ""sv : std::string_view{argv[i]};
+            continue;
+        } //if ( argument == "--micro"sv )
+
+        const auto value = toNumber(argv[i]);
+        if ( value < 0 || (value == 0 && argv[i] != "0"sv) ) {
+            myErr("{:s} is not a valid value for {:s}!\n", argv[i], argument);
+            return -3;
+        } //if ( value < 0 || (value == 0 && argv[i] != "0"sv) )
+
+        if ( argument == "--jobs"sv ) {
+            options.Jobs =
+                value == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : static_cast<std::size_t>(value);
+        } //if ( argument == "--jobs"sv )
+        else if ( argument == "--bench"sv ) {
+            options.BenchRuns = static_cast<std::size_t>(value);
+        } //else if ( argument == "--bench"sv )
+        else if ( argument == "--warmup"sv ) {
+            options.WarmUpRuns = static_cast<std::size_t>(value);
+        } //else if ( argument == "--warmup"sv )
+        else {
+            myErr("Unknown option {:s}!\n", argument);
+            return -3;
+        } //else -> if ( argument == "--jobs"sv )
+    } //for ( int i = 1; i < argc; ++i )
+
+    if ( options.Micro ) {
+        const MicroBenchmarkContext context{.WarmUpRuns = options.WarmUpRuns,
+                                            .Runs       = options.BenchRuns > 0 ? options.BenchRuns : 20};
+        if ( runMicroBenchmarks(options.MicroFilter, context) == 0 ) {
+            myErr("No micro benchmark matches {:s}!\n", options.MicroFilter);
+            return -4;
+        } //if ( runMicroBenchmarks(options.MicroFilter, context) == 0 )
+        return 0;
+    } //if ( options.Micro )
+
+    if ( arguments.size() < 2 ) {
         myErr("Not enough parameters!");
         return -1;
-    } //if ( argc < 3 )
+    } //if ( arguments.size() < 2 )
 
-    const std::filesystem::path dataDirectory{argv[1]};
+    const std::filesystem::path dataDirectory{arguments[0]};
 
     if ( !std::filesystem::exists(dataDirectory) ) {
         myErr("Path {:s} does not exist!", dataDirectory.native());
         return -2;
     } //if ( !std::filesystem::exists(dataDirectory) )
 
-    using Clock            = std::chrono::system_clock;
-
-    const std::span inputs = [&argc, &argv](void) noexcept {
-        std::span ret{argv + 2, argv + argc};
+    const std::span inputs = [&arguments](void) noexcept {
+        std::span<const std::string_view> ret{std::next(arguments.begin()), arguments.end()};
         if ( ret.size() == 1 && ret[0] == "0"sv ) {
-            static std::array<const char*, 12> all{"1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12"};
-            ret = std::span{all.data(), all.size()};
+            static constexpr std::array all{"1"sv, "2"sv, "3"sv, "4"sv,  "5"sv,  "6"sv,
+                                            "7"sv, "8"sv, "9"sv, "10"sv, "11"sv, "12"sv};
+            ret = all;
         } //if ( ret.size() == 1 && ret[0] == "0"sv )
         return ret;
     }();
-    std::vector<std::string_view> challengeInput;
-    const auto                    overallStart        = Clock::now();
-    int                           challengesRun       = 0;
-    int                           challengesSuccesful = 0;
-    auto runAndAdd = [&challengeInput, &challengesSuccesful](bool (*func)(const std::vector<std::string_view>&)) {
-        if ( func(challengeInput) ) {
-            ++challengesSuccesful;
-        } //if ( func(challengeInput) )
-        else {
-            myPrint("Failed\n");
-        } //else -> if ( func(challengeInput ) )
-        return;
-    };
 
-    for ( const auto& input : inputs ) {
-        const auto challenge = [](std::string_view text) noexcept -> std::int64_t {
-            try {
-                return convert(text);
-            } //try
-            catch ( ... ) {
-                return 0;
-            }
-        }({input, std::strlen(input)});
-
-        if ( challenge == 0 ) {
-            myErr("{:s} is not a valid challenge identifier!\n", input);
-            continue;
-        } //if ( challenge == 0 )
-
-        const auto inputFilePath = dataDirectory / std::format("{:d}.txt", challenge);
-
-        try {
-            ++challengesRun;
-            if ( !std::filesystem::exists(inputFilePath) ) {
-                throw std::runtime_error{std::format("\"{:s}\" does not exist!", inputFilePath.c_str())};
-            } //if ( !std::filesystem::exists(inputFilePath) )
-
-            if ( !std::filesystem::is_regular_file(inputFilePath) ) {
-                throw std::runtime_error{std::format("\"{:s}\" is not a file!", inputFilePath.c_str())};
-            } //if ( !std::filesystem::is_regular_file(inputFilePath) )
-
-            std::ifstream inputFile{inputFilePath};
-
-            if ( !inputFile ) {
-                throw std::runtime_error{std::format("Could not open \"{:s}\"!", inputFilePath.c_str())};
-            } //if ( !inputFile )
-
-            challengeInput.clear();
-            inputFile.seekg(0, std::ios::end);
-            const auto size = inputFile.tellg();
-            inputFile.seekg(0, std::ios::beg);
-            std::string fileContent(static_cast<std::size_t>(size), ' ');
-            inputFile.read(fileContent.data(), size);
-            std::ranges::copy(splitString<false>(fileContent, '\n'), std::back_inserter(challengeInput));
-            auto lastNonEmpty = std::ranges::find_last_if_not(challengeInput, &std::string_view::empty);
-            if ( lastNonEmpty.begin() != challengeInput.end() ) {
-                challengeInput.erase(std::next(lastNonEmpty.begin()), lastNonEmpty.end());
-            } //if ( lastNonEmpty.begin() != challengeInput.end() )
-
-            myPrint(" == Starting Challenge {:d} ==\n", challenge);
-            const auto start = Clock::now();
-
-            switch ( challenge ) {
-                case 1  : runAndAdd(challenge1); break;
-                case 2  : runAndAdd(challenge2); break;
-                case 3  : runAndAdd(challenge3); break;
-                case 4  : runAndAdd(challenge4); break;
-                case 5  : runAndAdd(challenge5); break;
-                case 6  : runAndAdd(challenge6); break;
-                case 7  : runAndAdd(challenge7); break;
-                case 8  : runAndAdd(challenge8); break;
-                case 9  : runAndAdd(challenge9); break;
-                case 10 : runAndAdd(challenge10); break;
-                case 11 : runAndAdd(challenge11); break;
-                case 12 : runAndAdd(challenge12); break;
-
-                default : {
-                    --challengesRun;
-                    myErr("Challenge {:d} is not known!\n", challenge);
-                    break;
-                } //default
-            } //switch ( challenge )
-
-            const auto end      = Clock::now();
-            const auto duration = end - start;
-            myPrint(" == End of Challenge {:d} after {} ==\n\n", challenge,
-                    std::chrono::duration_cast<std::chrono::milliseconds>(duration));
-        } //try
-        catch ( const std::exception& e ) {
-            --challengesRun;
-            myErr("Skipping Challenge {:d}: {:s}\n", challenge, e.what());
-        } //catch ( const std::exception& e)
-    } //for ( const auto& input : inputs )
-
-    const auto overallEnd      = Clock::now();
-    const auto overallDuration = overallEnd - overallStart;
+    const auto                overallStart = Clock::now();
+    std::vector<ChallengeRun> runs(inputs.size());
+
+    //Benchmarks run sequentially, concurrent challenges would distort the timings.
+    if ( options.Jobs > 1 && options.BenchRuns == 0 && inputs.size() > 1 ) {
+        std::vector<CapturedOutput> outputs(inputs.size());
+        {
+            const auto jobs = std::min(options.Jobs, inputs.size());
+            setConcurrentJobs(jobs);
+            ThreadPool pool{jobs};
+            for ( auto&& [input, run, output] : std::views::zip(inputs, runs, outputs) ) {
+                pool.submit([&dataDirectory, &options, input, &run, &output](void) {
+                    OutputCapture capture{output};
+                    run = runChallenge(dataDirectory, input, options);
+                    return;
+                });
+            } //for ( auto&& [input, run, output] : std::views::zip(inputs, runs, outputs) )
+            pool.wait();
+        }
+
+        for ( const auto& output : outputs ) {
+            myPrint("{:s}", output.Out);
+            myErr("{:s}", output.Err);
+        } //for ( const auto& output : outputs )
+    } //if ( options.Jobs > 1 && options.BenchRuns == 0 && inputs.size() > 1 )
+    else {
+        std::ranges::transform(inputs, runs.begin(), [&dataDirectory, &options](std::string_view input) {
+            return runChallenge(dataDirectory, input, options);
+        });
+    } //else -> if ( options.Jobs > 1 && options.BenchRuns == 0 && inputs.size() > 1 )
+
+    const auto challengesRun       = static_cast<int>(std::ranges::count_if(runs, &ChallengeRun::Run));
+    const auto challengesSuccesful = static_cast<int>(std::ranges::count_if(runs, &ChallengeRun::Successful));
+    const auto overallEnd          = Clock::now();
+    const auto overallDuration     = overallEnd - overallStart;
     myPrint("After {} {:d} challenges correctly solved from {:d} ({:.2f}%)\n",
             std::chrono::duration_cast<std::chrono::milliseconds>(overallDuration), challengesSuccesful, challengesRun,
             challengesSuccesful * 100. / std::max(challengesRun, 1));
 
+    if ( !options.TraceFile.empty() ) {
+        writeChromeTrace(options.TraceFile, runs, overallStart);
+    } //if ( !options.TraceFile.empty() )
+
     return 0;
 }
@@ -0,0 +1,80 @@
+#include "mappedfile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <format>
+#include <system_error>
+#include <utility>
+
+namespace {
+[[noreturn]] void throwSystemError(const std::filesystem::path& path, const char* what) {
+    throw std::system_error{errno, std::generic_category(), std::format("{:s} \"{:s}\"", what, path.c_str())};
+}
+} //namespace
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if ( fd == -1 ) {
+        throwSystemError(path, "Could not open");
+    } //if ( fd == -1 )
+
+    struct stat status{};
+    if ( ::fstat(fd, &status) == -1 ) {
+        ::close(fd);
+        throwSystemError(path, "Could not stat");
+    } //if ( ::fstat(fd, &status) == -1 )
+
+    Size = static_cast<std::size_t>(status.st_size);
+    if ( Size == 0 ) {
+        //mmap does not accept empty mappings.
+        ::close(fd);
+        return;
+    } //if ( Size == 0 )
+
+    void* mapping = ::mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if ( mapping == MAP_FAILED ) {
+        throwSystemError(path, "Could not map");
+    } //if ( mapping == MAP_FAILED )
+
+    //Only hints, failures are of no concern.
+    ::madvise(mapping, Size, MADV_SEQUENTIAL);
+    ::madvise(mapping, Size, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+    ::madvise(mapping, Size, MADV_HUGEPAGE);
+#endif
+    Data = static_cast<const char*>(mapping);
+    return;
+}
+
+MappedFile::MappedFile(MappedFile&& that) noexcept :
+        Data{std::exchange(that.Data, nullptr)}, Size{std::exchange(that.Size, 0)} {
+    return;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& that) noexcept {
+    if ( this != &that ) {
+        unmap();
+        Data = std::exchange(that.Data, nullptr);
+        Size = std::exchange(that.Size, 0);
+    } //if ( this != &that )
+    return *this;
+}
+
+MappedFile::~MappedFile(void) {
+    unmap();
+    return;
+}
+
+void MappedFile::unmap(void) noexcept {
+    if ( Data ) {
+        //NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        ::munmap(const_cast<char*>(Data), Size);
+        Data = nullptr;
+    } //if ( Data )
+    return;
+}
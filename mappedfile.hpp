@@ -0,0 +1,29 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+/**
+ * @brief A read only memory mapping of a whole file.
+ */
+class MappedFile {
+    public:
+    explicit MappedFile(const std::filesystem::path& path);
+    MappedFile(MappedFile&& that) noexcept;
+    MappedFile& operator=(MappedFile&& that) noexcept;
+    ~MappedFile(void);
+
+    [[nodiscard]] std::string_view content(void) const noexcept {
+        return {Data, Size};
+    }
+
+    private:
+    const char* Data = nullptr;
+    std::size_t Size = 0;
+
+    void unmap(void) noexcept;
+};
+
+#endif //MAPPEDFILE_HPP
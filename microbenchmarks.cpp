@@ -0,0 +1,367 @@
+#include "astar.hpp"
+#include "benchmark.hpp"
+#include "coordinate3d.hpp"
+#include "grid.hpp"
+#include "helper.hpp"
+#include "jps.hpp"
+#include "kdtree.hpp"
+#include "lineindex.hpp"
+#include "pointcloud.hpp"
+#include "print.hpp"
+#include "threadpool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <random>
+#include <ranges>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+struct NumberInput {
+    std::string                   Text;
+    std::vector<std::string_view> Lines;
+    std::vector<std::string_view> Numbers;
+};
+
+NumberInput generateNumbers(std::size_t lines) {
+    std::mt19937_64                             generator{42};
+    std::uniform_int_distribution<std::int64_t> distribution{-1'000'000'000, 1'000'000'000};
+
+    NumberInput ret;
+    for ( std::size_t line = 0; line < lines; ++line ) {
+        std::format_to(std::back_inserter(ret.Text), "{:d},{:d},{:d}\n", distribution(generator),
+                       distribution(generator) / 1000, distribution(generator) % 100);
+    } //for ( std::size_t line = 0; line < lines; ++line )
+
+    ret.Lines = splitIndexed(ret.Text, '\n');
+    for ( const auto line : ret.Lines ) {
+        indexDelimited(line, ',', /*skipEmpty=*/true, ret.Numbers);
+    } //for ( const auto line : ret.Lines )
+    return ret;
+}
+
+std::int64_t fromChars(std::string_view number) {
+    std::int64_t ret    = 0;
+    const auto   result = std::from_chars(number.data(), number.data() + number.size(), ret);
+    throwIfInvalid(result.ec == std::errc{});
+    return ret;
+}
+
+void benchmarkIntParser(const MicroBenchmarkContext& context) {
+    const auto input    = generateNumbers(100'000);
+    const auto parseAll = [&input](auto parse) {
+        return [&input, parse](void) {
+            std::int64_t sum = 0;
+            for ( const auto number : input.Numbers ) {
+                sum += parse(number);
+            } //for ( const auto number : input.Numbers )
+            doNotOptimize(sum);
+            return;
+        };
+    };
+
+    context.measure("std::from_chars (previous convert)", parseAll(fromChars));
+    context.measure("convert", parseAll(convert<10>));
+    context.measure("parseInt<Validated>", parseAll(parseInt<ParseMode::Validated>));
+    context.measure("parseInt<Unchecked>", parseAll(parseInt<ParseMode::Unchecked>));
+    context.measure("parseInt<Unchecked, 10>", parseAll(parseInt<ParseMode::Unchecked, 10>));
+
+    context.measure("split + convert per line", [&input](void) {
+        std::int64_t sum = 0;
+        for ( const auto line : input.Lines ) {
+            for ( const auto number : splitString(line, ',') ) {
+                sum += convert(number);
+            } //for ( const auto number : splitString(line, ',') )
+        } //for ( const auto line : input.Lines )
+        doNotOptimize(sum);
+        return;
+    });
+    context.measure("parseInts per line", [&input](void) {
+        std::int64_t                sum = 0;
+        std::array<std::int64_t, 3> numbers{};
+        for ( const auto line : input.Lines ) {
+            parseInts(line, ',', numbers);
+            sum += numbers[0] + numbers[1] + numbers[2];
+        } //for ( const auto line : input.Lines )
+        doNotOptimize(sum);
+        return;
+    });
+    return;
+}
+
+//The hash std::hash<Coordinate> used before, it collides for every grid wider than 256 columns.
+struct ShiftXorHash {
+    static std::size_t operator()(const Coordinate<std::int64_t>& c) noexcept {
+        std::hash<std::int64_t> h;
+        return h(c.Row << 8) ^ h(c.Column);
+    }
+};
+
+template<typename Set>
+void benchmarkCoordinateSet(const MicroBenchmarkContext& context, std::string_view label,
+                            std::span<const Coordinate<std::int64_t>> positions) {
+    context.measure(std::format("{:s} insert", label), [positions](void) {
+        Set set;
+        set.reserve(positions.size());
+        for ( const auto position : positions ) {
+            set.insert(position);
+        } //for ( const auto position : positions )
+        doNotOptimize(set);
+        return;
+    });
+
+    Set set;
+    set.reserve(positions.size() / 2);
+    for ( const auto position : positions | std::views::stride(2) ) {
+        set.insert(position);
+    } //for ( const auto position : positions | std::views::stride(2) )
+    context.measure(std::format("{:s} lookup (50% hits)", label), [positions, &set](void) {
+        std::size_t found = 0;
+        for ( const auto position : positions ) {
+            found += set.contains(position);
+        } //for ( const auto position : positions )
+        doNotOptimize(found);
+        return;
+    });
+    return;
+}
+
+void benchmarkCoordinateHash(const MicroBenchmarkContext& context) {
+    constexpr std::int64_t size      = 2000;
+    const auto             positions = CoordinateBounds<std::int64_t>{size, size}.allPositions() |
+                                       std::ranges::to<std::vector>();
+
+    benchmarkCoordinateSet<std::unordered_set<Coordinate<std::int64_t>, ShiftXorHash>>(
+        context, "unordered_set, shift xor hash", positions);
+    benchmarkCoordinateSet<std::unordered_set<Coordinate<std::int64_t>>>(context, "unordered_set, mixing hash",
+                                                                         positions);
+    benchmarkCoordinateSet<FlatHashSet<Coordinate<std::int64_t>>>(context, "FlatHashSet", positions);
+    return;
+}
+
+/**
+ * @brief Prints the work of a single search, which does not depend on the machine.
+ */
+template<typename Search>
+void reportWork(std::string_view label, const Search& search) {
+    AStar::SearchStatistics statistics;
+    search(statistics);
+    myPrint("   {:s}: {}\n", label, statistics);
+    return;
+}
+
+void benchmarkAStarGrid(const MicroBenchmarkContext& context) {
+    using Coordinate            = Grid<char>::Coordinate;
+    constexpr std::int64_t size = 2000;
+    constexpr char         Wall = '#';
+
+    std::mt19937_64             generator{42};
+    std::bernoulli_distribution isWall{0.2};
+    Grid<char>                  grid{size, size, '.', Wall};
+    for ( const auto index : grid.indices() ) {
+        grid[index] = isWall(generator) ? Wall : '.';
+    } //for ( const auto index : grid.indices() )
+
+    const Coordinate start{0, 0};
+    const Coordinate end{size - 1, size - 1};
+    grid[start]          = '.';
+    grid[end]            = '.';
+
+    const auto cost      = [](Coordinate, Coordinate) noexcept -> std::int64_t { return 1; };
+    const auto heuristic = [](Coordinate from, Coordinate to) noexcept { return (to - from).length(); };
+    const auto neighbors = [&grid](Coordinate position) noexcept {
+        return position.neighbors() |
+               std::views::filter([&grid](Coordinate next) noexcept { return grid[next] != Wall; });
+    };
+    //The border of the grid is a wall, so the jumps never leave it.
+    const auto passable  = [&grid](Coordinate position) noexcept { return grid[position] != Wall; };
+    const auto toIndex   = [](Coordinate position) noexcept { return position.Row * size + position.Column; };
+    const auto dense     = AStar::DenseStates{static_cast<std::size_t>(size * size), toIndex};
+
+    //The Manhattan distance ignores the walls, so A* still expands the cells around the detours. Without a heuristic
+    //(Dijkstra) almost every cell is expanded.
+    const auto zero      = [](Coordinate, Coordinate) noexcept -> std::int64_t { return 0; };
+
+    {
+        //Nothing else runs the jump point search, so check it against plain A* before timing it.
+        const auto diagonalHeuristic = [](Coordinate from, Coordinate to) noexcept {
+            return std::max(std::abs(to.Row - from.Row), std::abs(to.Column - from.Column));
+        };
+        const auto diagonalNeighbors = [&grid](Coordinate position) noexcept {
+            return position.neighborsWithDiagnonal() | std::views::filter([&grid, position](Coordinate next) noexcept {
+                       //No corner cutting, like Connectivity::Eight.
+                       return grid[next] != Wall && grid[Coordinate{next.Row, position.Column}] != Wall &&
+                              grid[Coordinate{position.Row, next.Column}] != Wall;
+                   });
+        };
+
+        const auto astarFour = AStar::search<AStar::Mode::Default>(start, end, cost, neighbors, heuristic, dense);
+        const auto jpsFour   = AStar::searchJumpPoints<AStar::Mode::Default, AStar::Connectivity::Four>(
+            start, end, cost, passable, heuristic, dense);
+        throwIfInvalid(jpsFour.Cost == astarFour.Cost, "4-connected JPS cost differs from A*");
+
+        const auto astarEight =
+            AStar::search<AStar::Mode::Default>(start, end, cost, diagonalNeighbors, diagonalHeuristic, dense);
+        const auto jpsEight   = AStar::searchJumpPoints<AStar::Mode::Default, AStar::Connectivity::Eight>(
+            start, end, cost, passable, diagonalHeuristic, dense);
+        throwIfInvalid(jpsEight.Cost == astarEight.Cost, "8-connected JPS cost differs from A*");
+    }
+
+    context.measure("A*, hashed states, indexed heap", [&](void) {
+        doNotOptimize(AStar::search<AStar::Mode::Default>(start, end, cost, neighbors, heuristic).Cost);
+        return;
+    });
+    context.measure("A*, hashed states, lazy heap", [&](void) {
+        doNotOptimize(
+            AStar::search<AStar::Mode::Default, AStar::LazyHeap>(start, end, cost, neighbors, heuristic).Cost);
+        return;
+    });
+    context.measure("A*, dense states, indexed heap", [&](void) {
+        doNotOptimize(AStar::search<AStar::Mode::Default>(start, end, cost, neighbors, heuristic, dense).Cost);
+        return;
+    });
+    context.measure("A*, dense states, lazy heap", [&](void) {
+        doNotOptimize(
+            AStar::search<AStar::Mode::Default, AStar::LazyHeap>(start, end, cost, neighbors, heuristic, dense).Cost);
+        return;
+    });
+    context.measure("Dijkstra, hashed states, indexed heap", [&](void) {
+        doNotOptimize(AStar::search<AStar::Mode::Default>(start, end, cost, neighbors, zero).Cost);
+        return;
+    });
+    context.measure("Dijkstra, dense states, indexed heap", [&](void) {
+        doNotOptimize(AStar::search<AStar::Mode::Default>(start, end, cost, neighbors, zero, dense).Cost);
+        return;
+    });
+    context.measure("JPS, hashed states, indexed heap", [&](void) {
+        doNotOptimize(AStar::searchJumpPoints<AStar::Mode::Default, AStar::Connectivity::Four>(
+                          start, end, cost, passable, heuristic)
+                          .Cost);
+        return;
+    });
+    context.measure("JPS, dense states, indexed heap", [&](void) {
+        doNotOptimize(AStar::searchJumpPoints<AStar::Mode::Default, AStar::Connectivity::Four>(
+                          start, end, cost, passable, heuristic, dense)
+                          .Cost);
+        return;
+    });
+    reportWork("A*, indexed heap, work", [&](AStar::SearchStatistics& statistics) {
+        AStar::search<AStar::Mode::Default>(start, end, cost, neighbors, heuristic, dense, statistics);
+        return;
+    });
+    reportWork("A*, lazy heap, work", [&](AStar::SearchStatistics& statistics) {
+        AStar::search<AStar::Mode::Default, AStar::LazyHeap>(start, end, cost, neighbors, heuristic, dense,
+                                                             statistics);
+        return;
+    });
+    reportWork("Dijkstra, work", [&](AStar::SearchStatistics& statistics) {
+        AStar::search<AStar::Mode::Default>(start, end, cost, neighbors, zero, dense, statistics);
+        return;
+    });
+    reportWork("JPS, work", [&](AStar::SearchStatistics& statistics) {
+        AStar::searchJumpPoints<AStar::Mode::Default, AStar::Connectivity::Four>(start, end, cost, passable,
+                                                                                 heuristic, dense, statistics);
+        return;
+    });
+
+    //Without walls every path is symmetric, the case JPS prunes best.
+    for ( const auto index : grid.indices() ) {
+        grid[index] = '.';
+    } //for ( const auto index : grid.indices() )
+    context.measure("open grid, Dijkstra, dense states", [&](void) {
+        doNotOptimize(AStar::search<AStar::Mode::Default>(start, end, cost, neighbors, zero, dense).Cost);
+        return;
+    });
+    context.measure("open grid, JPS Dijkstra, dense states", [&](void) {
+        doNotOptimize(AStar::searchJumpPoints<AStar::Mode::Default, AStar::Connectivity::Four>(
+                          start, end, cost, passable, zero, dense)
+                          .Cost);
+        return;
+    });
+    reportWork("open grid, Dijkstra, work", [&](AStar::SearchStatistics& statistics) {
+        AStar::search<AStar::Mode::Default>(start, end, cost, neighbors, zero, dense, statistics);
+        return;
+    });
+    reportWork("open grid, JPS Dijkstra, work", [&](AStar::SearchStatistics& statistics) {
+        AStar::searchJumpPoints<AStar::Mode::Default, AStar::Connectivity::Four>(start, end, cost, passable, zero,
+                                                                                 dense, statistics);
+        return;
+    });
+    return;
+}
+
+void benchmarkPointDistances(const MicroBenchmarkContext& context) {
+    constexpr std::size_t                       count = 1000;
+    std::mt19937_64                             generator{42};
+    std::uniform_int_distribution<std::int64_t> coordinate{0, 99'999};
+    std::vector<Coordinate3D<std::int64_t>>     boxes;
+    PointCloud                                  points;
+    for ( std::size_t i = 0; i < count; ++i ) {
+        boxes.push_back({coordinate(generator), coordinate(generator), coordinate(generator)});
+        points.push_back(boxes.back());
+    } //for ( std::size_t i = 0; i < count; ++i )
+
+    context.measure("Coordinate3D::length, all pairs", [&boxes](void) {
+        double sum = 0.;
+        for ( std::size_t i1 = 1; i1 < count; ++i1 ) {
+            for ( std::size_t i2 = 0; i2 < i1; ++i2 ) {
+                sum += (boxes[i1] - boxes[i2]).length();
+            } //for ( std::size_t i2 = 0; i2 < i1; ++i2 )
+        } //for ( std::size_t i1 = 1; i1 < count; ++i1 )
+        doNotOptimize(sum);
+        return;
+    });
+    context.measure("squaredDistances, all pairs", [&points](void) {
+        std::vector<std::uint64_t> row(count);
+        for ( std::size_t i1 = 1; i1 < count; ++i1 ) {
+            squaredDistances(points, i1, 0, std::span{row}.first(i1));
+            doNotOptimize(row);
+        } //for ( std::size_t i1 = 1; i1 < count; ++i1 )
+        return;
+    });
+    return;
+}
+
+void benchmarkNearestNeighbors(const MicroBenchmarkContext& context) {
+    constexpr std::size_t                       k = 16;
+    std::mt19937_64                             generator{42};
+    std::uniform_int_distribution<std::int64_t> coordinate{0, 99'999};
+    const std::size_t                           threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for ( const auto count : {1'000uz, 5'000uz, 10'000uz, 50'000uz} ) {
+        PointCloud points;
+        points.reserve(count);
+        for ( std::size_t i = 0; i < count; ++i ) {
+            points.push_back({coordinate(generator), coordinate(generator), coordinate(generator)});
+        } //for ( std::size_t i = 0; i < count; ++i )
+
+        const KdTree                  tree{points};
+        std::vector<KdTree::Neighbor> neighbors(count * k);
+        for ( const auto poolSize : {1uz, threads} ) {
+            ThreadPool pool{poolSize};
+            context.measure(std::format("nearestOfAll, {:d} boxes, {:d} threads", count, poolSize),
+                            [&tree, &neighbors, &pool](void) {
+                                tree.nearestOfAll(k, neighbors, pool);
+                                doNotOptimize(neighbors);
+                                return;
+                            });
+        } //for ( const auto poolSize : {1uz, threads} )
+    } //for ( const auto count : {1'000uz, 5'000uz, 10'000uz, 50'000uz} )
+    return;
+}
+
+[[maybe_unused]] const bool IntParserRegistered = registerMicroBenchmark("parser/int", benchmarkIntParser);
+[[maybe_unused]] const bool CoordinateHashRegistered =
+    registerMicroBenchmark("hash/coordinate", benchmarkCoordinateHash);
+[[maybe_unused]] const bool AStarGridRegistered = registerMicroBenchmark("astar/grid", benchmarkAStarGrid);
+[[maybe_unused]] const bool PointDistancesRegistered =
+    registerMicroBenchmark("pointcloud/distances", benchmarkPointDistances);
+[[maybe_unused]] const bool NearestNeighborsRegistered =
+    registerMicroBenchmark("kdtree/nearest", benchmarkNearestNeighbors);
+} //namespace
@@ -0,0 +1,108 @@
+#include "pointcloud.hpp"
+
+#include "helper.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+  #define POINTCLOUD_X86
+  #include <immintrin.h>
+#endif
+
+namespace {
+struct Query {
+    std::int64_t        X;
+    std::int64_t        Y;
+    std::int64_t        Z;
+    const std::int32_t* Xs;
+    const std::int32_t* Ys;
+    const std::int32_t* Zs;
+};
+
+std::uint64_t squaredDistance(const Query& query, std::size_t i) noexcept {
+    const auto dx = static_cast<std::uint64_t>(query.Xs[i] - query.X);
+    const auto dy = static_cast<std::uint64_t>(query.Ys[i] - query.Y);
+    const auto dz = static_cast<std::uint64_t>(query.Zs[i] - query.Z);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+void squaredDistancesScalar(const Query& query, std::span<std::uint64_t> out) noexcept {
+    for ( std::size_t i = 0; i < out.size(); ++i ) {
+        out[i] = squaredDistance(query, i);
+    } //for ( std::size_t i = 0; i < out.size(); ++i )
+    return;
+}
+
+#ifdef POINTCLOUD_X86
+__attribute__((target("avx2"))) __m256i load4(const std::int32_t* values) noexcept {
+    //NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values)));
+}
+
+__attribute__((target("avx2"))) void squaredDistancesAvx2(const Query& query, std::span<std::uint64_t> out) noexcept {
+    const auto  x = _mm256_set1_epi64x(query.X);
+    const auto  y = _mm256_set1_epi64x(query.Y);
+    const auto  z = _mm256_set1_epi64x(query.Z);
+    std::size_t i = 0;
+    for ( ; i + 4 <= out.size(); i += 4 ) {
+        //The differences fit into the lower 32 bits, which _mm256_mul_epi32 multiplies to the full 64 bit product.
+        const auto dx  = _mm256_sub_epi64(load4(query.Xs + i), x);
+        const auto dy  = _mm256_sub_epi64(load4(query.Ys + i), y);
+        const auto dz  = _mm256_sub_epi64(load4(query.Zs + i), z);
+        auto       sum = _mm256_mul_epi32(dx, dx);
+        sum            = _mm256_add_epi64(sum, _mm256_mul_epi32(dy, dy));
+        sum            = _mm256_add_epi64(sum, _mm256_mul_epi32(dz, dz));
+        //NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.data() + i), sum);
+    } //for ( ; i + 4 <= out.size(); i += 4 )
+
+    for ( ; i < out.size(); ++i ) {
+        out[i] = squaredDistance(query, i);
+    } //for ( ; i < out.size(); ++i )
+    return;
+}
+#endif
+
+using Kernel = void (*)(const Query&, std::span<std::uint64_t>) noexcept;
+
+Kernel selectKernel(void) noexcept {
+#ifdef POINTCLOUD_X86
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports("avx2") ) {
+        return squaredDistancesAvx2;
+    } //if ( __builtin_cpu_supports("avx2") )
+#endif
+    return squaredDistancesScalar;
+}
+
+bool isWithinLimit(std::int64_t value) noexcept {
+    return value >= -PointCloud::Limit && value < PointCloud::Limit;
+}
+} //namespace
+
+void PointCloud::reserve(std::size_t count) {
+    X.reserve(count);
+    Y.reserve(count);
+    Z.reserve(count);
+    return;
+}
+
+void PointCloud::push_back(const Coordinate3D<std::int64_t>& point) {
+    throwIfInvalid(isWithinLimit(point.X) && isWithinLimit(point.Y) && isWithinLimit(point.Z),
+                   "Coordinate out of range");
+    X.push_back(static_cast<std::int32_t>(point.X));
+    Y.push_back(static_cast<std::int32_t>(point.Y));
+    Z.push_back(static_cast<std::int32_t>(point.Z));
+    return;
+}
+
+void squaredDistances(const PointCloud& points, std::size_t index, std::size_t first, std::span<std::uint64_t> out) {
+    squaredDistances(points, points[index], first, out);
+    return;
+}
+
+void squaredDistances(const PointCloud& points, const Coordinate3D<std::int64_t>& from, std::size_t first,
+                      std::span<std::uint64_t> out) {
+    static const Kernel kernel = selectKernel();
+    kernel({from.X, from.Y, from.Z, points.xs().data() + first, points.ys().data() + first, points.zs().data() + first},
+           out);
+    return;
+}
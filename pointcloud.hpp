@@ -0,0 +1,64 @@
+#ifndef POINTCLOUD_HPP
+#define POINTCLOUD_HPP
+
+#include "coordinate3d.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @brief 3D points with integer coordinates, stored as one array per axis.
+ *
+ * The coordinates have to be within [-Limit, Limit), so every difference fits into 32 bits and every squared distance
+ * into an unsigned 64 bit integer, without any rounding.
+ */
+class PointCloud {
+    public:
+    static constexpr std::int64_t Limit = std::int64_t{1} << 30;
+
+    void reserve(std::size_t count);
+    void push_back(const Coordinate3D<std::int64_t>& point);
+
+    std::size_t size(void) const noexcept {
+        return X.size();
+    }
+
+    Coordinate3D<std::int64_t> operator[](std::size_t index) const noexcept {
+        return {X[index], Y[index], Z[index]};
+    }
+
+    std::span<const std::int32_t> xs(void) const noexcept {
+        return X;
+    }
+
+    std::span<const std::int32_t> ys(void) const noexcept {
+        return Y;
+    }
+
+    std::span<const std::int32_t> zs(void) const noexcept {
+        return Z;
+    }
+
+    private:
+    std::vector<std::int32_t> X;
+    std::vector<std::int32_t> Y;
+    std::vector<std::int32_t> Z;
+};
+
+/**
+ * @brief Writes the squared euclidean distances from points[index] to points[first, first + out.size()) into out.
+ *
+ * Computes 4 distances at once with AVX2, chosen at runtime, with a scalar fallback. Both give the exact values.
+ */
+void squaredDistances(const PointCloud& points, std::size_t index, std::size_t first, std::span<std::uint64_t> out);
+
+/**
+ * @brief Writes the squared euclidean distances from from to points[first, first + out.size()) into out.
+ * @param from Has to be within the limits of PointCloud.
+ */
+void squaredDistances(const PointCloud& points, const Coordinate3D<std::int64_t>& from, std::size_t first,
+                      std::span<std::uint64_t> out);
+
+#endif //POINTCLOUD_HPP
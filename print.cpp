@@ -1,11 +1,101 @@
 #include "print.hpp"
 
-#include <iostream>
+#include <unistd.h>
 
-std::ostream_iterator<char> outIterator{std::cout};
-std::ostream_iterator<char> errIterator{std::cerr};
+#include <cerrno>
+#include <string_view>
+#include <utility>
+
+namespace {
+thread_local CapturedOutput* Capture = nullptr;
+
+void writeAll(int fd, std::string_view data) noexcept {
+    while ( !data.empty() ) {
+        const auto written = ::write(fd, data.data(), data.size());
+        if ( written < 0 ) {
+            if ( errno == EINTR ) {
+                continue;
+            } //if ( errno == EINTR )
+            //Nowhere left to report to.
+            return;
+        } //if ( written < 0 )
+        data.remove_prefix(static_cast<std::size_t>(written));
+    } //while ( !data.empty() )
+    return;
+}
+
+class Buffer {
+    public:
+    static constexpr std::size_t FlushThreshold = 64 * 1024;
+
+    explicit Buffer(int fd) noexcept : Fd{fd} {
+        return;
+    }
+
+    Buffer(const Buffer&)            = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    ~Buffer(void) {
+        flush();
+        return;
+    }
+
+    std::string& text(void) noexcept {
+        return Text;
+    }
+
+    void flush(void) noexcept {
+        writeAll(Fd, Text);
+        Text.clear();
+        return;
+    }
+
+    private:
+    int         Fd;
+    std::string Text;
+};
+
+thread_local Buffer OutBuffer{STDOUT_FILENO};
+thread_local Buffer ErrBuffer{STDERR_FILENO};
+} //namespace
+
+OutputCapture::OutputCapture(CapturedOutput& target) noexcept : Previous{std::exchange(Capture, &target)} {
+    return;
+}
+
+OutputCapture::~OutputCapture(void) {
+    Capture = Previous;
+    return;
+}
+
+CapturedOutput* currentCapture(void) noexcept {
+    return Capture;
+}
+
+std::string& Output::outBuffer(void) noexcept {
+    return Capture ? Capture->Out : OutBuffer.text();
+}
+
+std::string& Output::errBuffer(void) noexcept {
+    return Capture ? Capture->Err : ErrBuffer.text();
+}
+
+void Output::outWritten(void) noexcept {
+    if ( !Capture && OutBuffer.text().size() >= Buffer::FlushThreshold ) {
+        OutBuffer.flush();
+    } //if ( !Capture && OutBuffer.text().size() >= Buffer::FlushThreshold )
+    return;
+}
+
+void Output::errWritten(void) noexcept {
+    if ( !Capture ) {
+        OutBuffer.flush();
+        ErrBuffer.flush();
+    } //if ( !Capture )
+    return;
+}
 
 void myFlush() {
-    std::cout.flush();
+    OutBuffer.flush();
     return;
 }
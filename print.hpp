@@ -3,19 +3,53 @@
 
 #include <format>
 #include <iterator>
-#include <ostream>
+#include <string>
 
-extern std::ostream_iterator<char> outIterator;
-extern std::ostream_iterator<char> errIterator;
+struct CapturedOutput {
+    std::string Out;
+    std::string Err;
+};
+
+/**
+ * @brief Redirects myPrint and myErr of the current thread into the given buffers, as long as the object lives.
+ */
+class OutputCapture {
+    public:
+    explicit OutputCapture(CapturedOutput& target) noexcept;
+    OutputCapture(const OutputCapture&)            = delete;
+    OutputCapture& operator=(const OutputCapture&) = delete;
+    ~OutputCapture(void);
+
+    private:
+    CapturedOutput* Previous;
+};
+
+CapturedOutput* currentCapture(void) noexcept;
+
+/**
+ * Every thread formats into its own buffers, which are written with a single write(2). Standard output is flushed when
+ * the buffer is full, on myFlush() and on thread exit, standard error after every myErr() (after flushing the thread's
+ * standard output, to keep the order).
+ */
+namespace Output {
+std::string& outBuffer(void) noexcept;
+std::string& errBuffer(void) noexcept;
+void         outWritten(void) noexcept;
+void         errWritten(void) noexcept;
+} //namespace Output
 
 template<typename... Args>
 void myPrint(std::format_string<Args...> str, Args&&... args) {
-    std::format_to(outIterator, str, std::forward<Args>(args)...);
+    std::format_to(std::back_inserter(Output::outBuffer()), str, std::forward<Args>(args)...);
+    Output::outWritten();
+    return;
 }
 
 template<typename... Args>
 void myErr(std::format_string<Args...> str, Args&&... args) {
-    std::format_to(errIterator, str, std::forward<Args>(args)...);
+    std::format_to(std::back_inserter(Output::errBuffer()), str, std::forward<Args>(args)...);
+    Output::errWritten();
+    return;
 }
 
 void myFlush();
@@ -0,0 +1,112 @@
+#include "threadpool.hpp"
+
+#include <algorithm>
+
+namespace {
+thread_local const ThreadPool* CurrentPool  = nullptr;
+thread_local std::size_t       CurrentIndex = 0;
+std::atomic<std::size_t>       ConcurrentJobs{1};
+} //namespace
+
+void setConcurrentJobs(std::size_t jobs) noexcept {
+    ConcurrentJobs = std::max<std::size_t>(jobs, 1);
+    return;
+}
+
+std::size_t threadsPerJob(void) noexcept {
+    return std::max<std::size_t>(std::thread::hardware_concurrency() / ConcurrentJobs, 1);
+}
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    threads = std::max<std::size_t>(threads, 1);
+    Queues.reserve(threads);
+    for ( std::size_t i = 0; i < threads; ++i ) {
+        Queues.push_back(std::make_unique<Queue>());
+    } //for ( std::size_t i = 0; i < threads; ++i )
+
+    Threads.reserve(threads);
+    for ( std::size_t i = 0; i < threads; ++i ) {
+        Threads.emplace_back([this, i](void) { work(i); });
+    } //for ( std::size_t i = 0; i < threads; ++i )
+    return;
+}
+
+ThreadPool::~ThreadPool(void) {
+    wait();
+    {
+        std::lock_guard lock{StateMutex};
+        Stopping = true;
+    }
+    WorkAvailable.notify_all();
+    Threads.clear();
+    return;
+}
+
+void ThreadPool::submit(Task task) {
+    const auto index = CurrentPool == this ? CurrentIndex : NextQueue++ % Queues.size();
+    {
+        //Count the task before it becomes visible, a worker may take and finish it right after the push.
+        std::lock_guard stateLock{StateMutex};
+        ++Queued;
+        ++Unfinished;
+        std::lock_guard queueLock{Queues[index]->Mutex};
+        Queues[index]->Tasks.push_back(std::move(task));
+    }
+    WorkAvailable.notify_one();
+    return;
+}
+
+void ThreadPool::wait(void) {
+    std::unique_lock lock{StateMutex};
+    AllDone.wait(lock, [this](void) noexcept { return Unfinished == 0; });
+    return;
+}
+
+bool ThreadPool::popOwn(std::size_t index, Task& task) {
+    auto&           queue = *Queues[index];
+    std::lock_guard lock{queue.Mutex};
+    if ( queue.Tasks.empty() ) {
+        return false;
+    } //if ( queue.Tasks.empty() )
+    task = std::move(queue.Tasks.back());
+    queue.Tasks.pop_back();
+    --Queued;
+    return true;
+}
+
+bool ThreadPool::steal(std::size_t thief, Task& task) {
+    for ( std::size_t offset = 1; offset < Queues.size(); ++offset ) {
+        auto&           queue = *Queues[(thief + offset) % Queues.size()];
+        std::lock_guard lock{queue.Mutex};
+        if ( queue.Tasks.empty() ) {
+            continue;
+        } //if ( queue.Tasks.empty() )
+        task = std::move(queue.Tasks.front());
+        queue.Tasks.pop_front();
+        --Queued;
+        return true;
+    } //for ( std::size_t offset = 1; offset < Queues.size(); ++offset )
+    return false;
+}
+
+void ThreadPool::work(std::size_t index) {
+    CurrentPool  = this;
+    CurrentIndex = index;
+
+    while ( true ) {
+        if ( Task task; popOwn(index, task) || steal(index, task) ) {
+            task();
+            std::lock_guard lock{StateMutex};
+            if ( --Unfinished == 0 ) {
+                AllDone.notify_all();
+            } //if ( --Unfinished == 0 )
+            continue;
+        } //if ( Task task; popOwn(index, task) || steal(index, task) )
+
+        std::unique_lock lock{StateMutex};
+        WorkAvailable.wait(lock, [this](void) noexcept { return Stopping || Queued > 0; });
+        if ( Stopping && Queued == 0 ) {
+            return;
+        } //if ( Stopping && Queued == 0 )
+    } //while ( true )
+}
@@ -0,0 +1,91 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A work stealing thread pool.
+ *
+ * Every worker owns a queue, it takes its own work from the back and steals from the front of the other queues when
+ * its own is empty. Tasks submitted from within a worker land in the queue of that worker, everything else is
+ * distributed round robin.
+ */
+class ThreadPool {
+    public:
+    using Task = std::function<void(void)>;
+
+    explicit ThreadPool(std::size_t threads);
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool(void);
+
+    void submit(Task task);
+
+    /**
+     * @brief Blocks until every submitted task has finished.
+     */
+    void wait(void);
+
+    [[nodiscard]] std::size_t size(void) const noexcept {
+        return Threads.size();
+    }
+
+    private:
+    struct Queue {
+        std::mutex       Mutex;
+        std::deque<Task> Tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> Queues;
+    std::vector<std::jthread>           Threads;
+    std::atomic<std::size_t>            NextQueue{0};
+    std::atomic<std::size_t>            Queued{0};
+    std::size_t                         Unfinished{0};
+    std::mutex                          StateMutex;
+    std::condition_variable             WorkAvailable;
+    std::condition_variable             AllDone;
+    bool                                Stopping{false};
+
+    bool popOwn(std::size_t index, Task& task);
+    bool steal(std::size_t thief, Task& task);
+    void work(std::size_t index);
+};
+
+/**
+ * @brief Sets how many jobs run concurrently, so that the pools within the jobs share the hardware threads.
+ */
+void setConcurrentJobs(std::size_t jobs) noexcept;
+
+/**
+ * @brief The number of threads a pool within one job should have, at least one.
+ */
+std::size_t threadsPerJob(void) noexcept;
+
+/**
+ * @brief Calls body(first, last) for every tile [first, last) of [0, count), each at most tileSize long, on pool and
+ * waits for all of them.
+ *
+ * Must not be called from within a task of pool, because it waits for the calling task too.
+ */
+template<typename Body>
+void parallelFor(ThreadPool& pool, std::size_t count, std::size_t tileSize, const Body& body) {
+    for ( std::size_t first = 0; first < count; first += tileSize ) {
+        pool.submit([&body, first, last = std::min(first + tileSize, count)](void) {
+            body(first, last);
+            return;
+        });
+    } //for ( std::size_t first = 0; first < count; first += tileSize )
+    pool.wait();
+    return;
+}
+
+#endif //THREADPOOL_HPP